@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <array>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <attributes.hpp>
+#include "bench.hpp"
+
+namespace {
+// Names as they would arrive from a template or configuration
+const std::array<std::string_view, 8> names = {
+	"href", "title", "width", "data-user", "aria-label", "tabindex", "wrap", "accept"
+};
+
+std::optional<std::size_t> findByScan(std::string_view name) {
+	const auto found = std::find_if(std::begin(Web::standardAttributes), std::end(Web::standardAttributes),
+		[name](const Web::StandardAttribute& attribute) { return attribute.name == name; });
+	if (found == std::end(Web::standardAttributes)) {
+		return std::nullopt;
+	}
+	return static_cast<std::size_t>(found - std::begin(Web::standardAttributes));
+}
+}
+
+WEB_BENCHMARK("attributes/name lookup with the perfect hash")
+{
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		for (const std::string_view name : names) {
+			Bench::doNotOptimize(Web::findStandardAttribute(name));
+		}
+	}
+	state.setItemsPerIteration(names.size());
+}
+
+WEB_BENCHMARK("attributes/name lookup with a linear scan")
+{
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		for (const std::string_view name : names) {
+			Bench::doNotOptimize(findByScan(name));
+		}
+	}
+	state.setItemsPerIteration(names.size());
+}
+
+WEB_BENCHMARK("attributes/typed attributes on a link")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	const Web::Url url{ "/products/42" };
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		stream << Web::A{
+			Web::Attr{
+				Web::Attribute<"href">{ url },
+				Web::Attribute<"title">{ "Product" },
+				Web::Attribute<"tabindex">{ 3 },
+				Web::Data<"row">{ i },
+				Web::Attribute<"rel", "nofollow">{}
+			},
+			"Product"
+		};
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
+
+WEB_BENCHMARK("attributes/AttributeSet assembled at runtime on a link")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	const Web::Url url{ "/products/42" };
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		Web::AttributeSet attributes;
+		attributes.add("href", url);
+		attributes.add("title", "Product");
+		attributes.add("tabindex", 3);
+		attributes.add("data-row", i);
+		attributes.add("rel", "nofollow");
+		stream << Web::A{ Web::Attr{ std::move(attributes) }, "Product" };
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
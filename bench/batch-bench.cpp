@@ -0,0 +1,82 @@
+#include <ostream>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <batch.hpp>
+#include "bench.hpp"
+
+namespace {
+struct Notification {
+	std::string name;
+	std::string subject;
+	int unread;
+};
+
+const auto buildEmail = [](const auto& name, const auto& subject, const auto& unread) {
+	return Web::Html {
+		Web::Body {
+			Web::Header{ Web::Attr{ Web::Class<"banner">{} }, Web::H1{ "Hello ", name } },
+			Web::Main {
+				Web::P{ "You have a new message: ", Web::Strong{ subject } },
+				Web::P{ "Unread messages: ", unread },
+				Web::P{ Web::A{ "Open your inbox" } }
+			},
+			Web::Footer{ Web::P{ "You are receiving this email because you signed up for notifications." } }
+		}
+	};
+};
+
+const auto extractNotification = [](const Notification& n) {
+	return std::tie(n.name, n.subject, n.unread);
+};
+
+const std::vector<Notification> notifications = [] {
+	std::vector<Notification> result;
+	for (int i = 0; i < 1000; ++i) {
+		result.push_back(Notification{ "User " + std::to_string(i), "Weekly report #" + std::to_string(i), i % 50 });
+	}
+	return result;
+}();
+
+void reportBatch(Bench::State& state, std::size_t bytes) {
+	state.setItemsPerIteration(notifications.size());
+	state.setBytesPerIteration(bytes);
+}
+}
+
+WEB_BENCHMARK("batch/tree built per document (1000 docs)")
+{
+	std::size_t bytes = 0;
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		std::string out;
+		for (const auto& n : notifications) {
+			Web::render(out, buildEmail(n.name, n.subject, n.unread));
+		}
+		bytes = out.size();
+		Bench::doNotOptimize(out);
+	}
+	reportBatch(state, bytes);
+}
+
+WEB_BENCHMARK("batch/renderBatch one thread (1000 docs)")
+{
+	std::size_t bytes = 0;
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		const auto output = Web::renderBatch(std::span(notifications), buildEmail, extractNotification);
+		bytes = output.getBytes().size();
+		Bench::doNotOptimize(output);
+	}
+	reportBatch(state, bytes);
+}
+
+WEB_BENCHMARK("batch/renderBatch all threads (1000 docs)")
+{
+	std::size_t bytes = 0;
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		const auto output = Web::renderBatch(std::span(notifications), buildEmail, extractNotification, { .threads = 0, .reservePerDocument = 512 });
+		bytes = output.getBytes().size();
+		Bench::doNotOptimize(output);
+	}
+	reportBatch(state, bytes);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+
+namespace Bench {
+
+	class State {
+		std::size_t iterations;
+		std::size_t bytesPerIteration = 0;
+		std::size_t itemsPerIteration = 0;
+	public:
+		explicit State(std::size_t iterations) :
+			iterations(iterations)
+		{}
+
+		std::size_t getIterations() const {
+			return iterations;
+		}
+
+		// Reports throughput in MB/s when set
+		void setBytesPerIteration(std::size_t bytes) {
+			bytesPerIteration = bytes;
+		}
+		std::size_t getBytesPerIteration() const {
+			return bytesPerIteration;
+		}
+
+		// Reports throughput in items/s when set
+		void setItemsPerIteration(std::size_t items) {
+			itemsPerIteration = items;
+		}
+		std::size_t getItemsPerIteration() const {
+			return itemsPerIteration;
+		}
+	};
+
+	using BenchmarkFunction = std::function<void(State&)>;
+
+	struct Benchmark {
+		std::string name;
+		BenchmarkFunction function;
+	};
+
+	inline std::vector<Benchmark>& registry() {
+		static std::vector<Benchmark> benchmarks;
+		return benchmarks;
+	}
+
+	struct Registrar {
+		Registrar(std::string name, BenchmarkFunction function) {
+			registry().push_back(Benchmark{ std::move(name), std::move(function) });
+		}
+	};
+
+	template <typename T>
+	inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+		(void)*sink;
+#endif
+	}
+
+	// A stream buffer that discards output but counts it, so render
+	// benchmarks measure rendering rather than buffer growth
+	class NullBuffer : public std::streambuf {
+		std::size_t count = 0;
+	public:
+		std::size_t getCount() const {
+			return count;
+		}
+	protected:
+		std::streamsize xsputn(const char* /*s*/, std::streamsize n) override {
+			count += static_cast<std::size_t>(n);
+			return n;
+		}
+		int_type overflow(int_type ch) override {
+			++count;
+			return traits_type::not_eof(ch);
+		}
+	};
+}
+
+#define WEB_BENCHMARK_CONCAT_IMPL(A, B) A##B
+#define WEB_BENCHMARK_CONCAT(A, B) WEB_BENCHMARK_CONCAT_IMPL(A, B)
+
+#define WEB_BENCHMARK(NAME)																\
+	static void WEB_BENCHMARK_CONCAT(benchmark_, __LINE__)(Bench::State& state);		\
+	static const Bench::Registrar WEB_BENCHMARK_CONCAT(registrar_, __LINE__){ NAME,	\
+		WEB_BENCHMARK_CONCAT(benchmark_, __LINE__) };									\
+	static void WEB_BENCHMARK_CONCAT(benchmark_, __LINE__)(Bench::State& state)
@@ -0,0 +1,58 @@
+#include <sstream>
+#include <string>
+#include <vector>
+#include <buffer-pool.hpp>
+#include <render.hpp>
+#include <web.hpp>
+#include "bench.hpp"
+
+namespace {
+struct ListingPage {};
+
+const Web::Ul& page() {
+	static const Web::Ul list = [] {
+		std::vector<Web::Li> items;
+		for (int i = 0; i < 2000; ++i) {
+			items.push_back(Web::Li{ "Listing entry ", i });
+		}
+		return Web::Ul{ std::move(items) };
+	}();
+	return list;
+}
+}
+
+WEB_BENCHMARK("buffer-pool/fresh ostringstream per render")
+{
+	std::size_t bytes = 0;
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		std::ostringstream stream;
+		stream << page();
+		bytes = static_cast<std::size_t>(stream.tellp());
+		Bench::doNotOptimize(stream);
+	}
+	state.setBytesPerIteration(bytes);
+}
+
+WEB_BENCHMARK("buffer-pool/fresh string per render")
+{
+	std::size_t bytes = 0;
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		std::string out;
+		Web::render(out, page());
+		bytes = out.size();
+		Bench::doNotOptimize(out);
+	}
+	state.setBytesPerIteration(bytes);
+}
+
+WEB_BENCHMARK("buffer-pool/pooled chunked buffer per render")
+{
+	std::size_t bytes = 0;
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		auto buffer = Web::BufferPool::local().acquire<ListingPage>();
+		Web::render(buffer, page());
+		bytes = buffer.size();
+		Bench::doNotOptimize(buffer);
+	}
+	state.setBytesPerIteration(bytes);
+}
@@ -0,0 +1,47 @@
+#include <ostream>
+#include <string>
+#include <class-list.hpp>
+#include "bench.hpp"
+
+// A utility CSS button: 16 fixed classes and 4 that depend on its state
+
+WEB_BENCHMARK("class-list/classes concatenated into a Class")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		const bool primary = i % 2 == 0;
+		const bool disabled = i % 3 == 0;
+		std::string classes = "inline-flex items-center justify-center gap-2 rounded-md border px-4 py-2 "
+			"text-sm font-medium shadow-sm transition-colors focus:outline-none focus:ring-2 focus:ring-offset-2 select-none";
+		classes += primary ? " bg-blue-600 text-white" : " bg-white text-gray-700";
+		if (disabled) {
+			classes += " opacity-50 cursor-not-allowed";
+		}
+		stream << Web::Span{ Web::Attr{ Web::Class{ std::move(classes) } }, "Save" };
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
+
+WEB_BENCHMARK("class-list/ClassList with conditional classes")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		const bool primary = i % 2 == 0;
+		const bool disabled = i % 3 == 0;
+		stream << Web::Span{
+			Web::Attr{
+				Web::ClassList<"inline-flex", "items-center", "justify-center", "gap-2", "rounded-md", "border", "px-4", "py-2",
+					"text-sm", "font-medium", "shadow-sm", "transition-colors", "focus:outline-none", "focus:ring-2",
+					"focus:ring-offset-2", "select-none">{
+					Web::ClassIf<"bg-blue-600">{ primary }, Web::ClassIf<"text-white">{ primary },
+					Web::ClassIf<"bg-white">{ !primary }, Web::ClassIf<"text-gray-700">{ !primary },
+					Web::ClassIf<"opacity-50">{ disabled }, Web::ClassIf<"cursor-not-allowed">{ disabled }
+				}
+			},
+			"Save"
+		};
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
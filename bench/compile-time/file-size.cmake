@@ -0,0 +1,12 @@
+# Prints the total size of FILES (separated by '|') under LABEL.
+
+string(REPLACE "|" ";" files "${FILES}")
+
+set(total 0)
+foreach(file ${files})
+	file(SIZE ${file} size)
+	math(EXPR total "${total} + ${size}")
+endforeach()
+
+math(EXPR kilobytes "${total} / 1024")
+message("${LABEL}: ${kilobytes} KiB")
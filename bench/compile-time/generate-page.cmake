@@ -0,0 +1,70 @@
+# Writes a translation unit that builds one static page of roughly
+# 12 * SECTIONS + 5 elements to OUTPUT.
+#
+# With PARTS set, each section is instead a Web::Component built in one of
+# PARTS further translation units, written next to OUTPUT as
+# <name>-part-<n>.cpp.
+
+set(sections "")
+set(declarations "")
+if(PARTS)
+	get_filename_component(directory ${OUTPUT} DIRECTORY)
+	get_filename_component(name ${OUTPUT} NAME_WE)
+	foreach(part RANGE 1 ${PARTS})
+		set(part_${part} "")
+	endforeach()
+endif()
+
+foreach(i RANGE 1 ${SECTIONS})
+	set(section "
+				Web::Section {
+					Web::H2{ \"Section ${i}\" },
+					Web::P{ \"Some text \", Web::Strong{ \"bold\" }, \" and \", Web::Em{ \"emphasis\" }, Web::Span{ Web::A{ \"link\" } } },
+					Web::Ul {
+						Web::Li{ \"first\" },
+						Web::Li{ \"second\" },
+						Web::Li{ Web::P{ \"third\" } }
+					}
+				}")
+	if(PARTS)
+		math(EXPR part "(${i} - 1) % ${PARTS} + 1")
+		string(APPEND part_${part} "
+Web::Component makeSection${i}()
+{
+	return Web::Component {${section}
+	};
+}
+")
+		string(APPEND declarations "Web::Component makeSection${i}();\n")
+		string(APPEND sections "
+				makeSection${i}(),")
+	else()
+		string(APPEND sections "${section},")
+	endif()
+endforeach()
+string(REGEX REPLACE ",$" "" sections "${sections}")
+
+if(PARTS)
+	foreach(part RANGE 1 ${PARTS})
+		file(WRITE ${directory}/${name}-part-${part}.cpp "// Generated by generate-page.cmake. Do not edit.
+#include <component.hpp>
+${part_${part}}")
+	endforeach()
+	set(include "#include <component.hpp>\n\n${declarations}")
+else()
+	set(include "#include <web.hpp>\n")
+endif()
+
+file(WRITE ${OUTPUT} "// Generated by generate-page.cmake. Do not edit.
+${include}
+Web::Html makePage()
+{
+	return Web::Html {
+		Web::Head{ Web::Title{ \"Generated page\" } },
+		Web::Body {
+			Web::Main {${sections}
+			}
+		}
+	};
+}
+")
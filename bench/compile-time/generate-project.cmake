@@ -0,0 +1,32 @@
+# Writes COUNT translation units to DIRECTORY, named unit-<n>.cpp, each
+# rendering a small page and parsing a fragment, as the request handlers
+# of a web application would.
+
+foreach(i RANGE 1 ${COUNT})
+	file(WRITE ${DIRECTORY}/unit-${i}.cpp "// Generated by generate-project.cmake. Do not edit.
+#include <ostream>
+#include <string>
+#include <web.hpp>
+#include <parser.hpp>
+
+void renderPage${i}(std::ostream& stream, const std::string& user)
+{
+	stream << Web::Html {
+		Web::Head{ Web::Title{ \"Page ${i}\" } },
+		Web::Body {
+			Web::Header{ Web::Nav{ Web::Ul{ Web::Li{ Web::A{ \"Home\" } }, Web::Li{ Web::A{ \"Page ${i}\" } } } } },
+			Web::Main {
+				Web::H1{ \"Page ${i}\" },
+				Web::P{ \"Hello \", Web::Strong{ user }, \", this is page \", ${i} },
+				Web::Div{ Web::Attr{ Web::Class<\"card\">{} }, Web::Span{ \"card ${i}\" }, Web::Em{ \"note\" } },
+				Web::Table{ Web::Tr{ Web::Th{ \"Name\" }, Web::Th{ \"Value\" } }, Web::Tr{ Web::Td{ user }, Web::Td{ ${i} } } }
+			},
+			Web::Footer{ Web::P{ \"(c) Example\" } }
+		}
+	};
+	if (auto document = Web::parseHtml(\"<p>fragment ${i}</p>\")) {
+		stream << *document;
+	}
+}
+")
+endforeach()
@@ -0,0 +1,19 @@
+# Compiles each of SOURCES (separated by '|') to an object with COMMAND
+# (arguments separated by '|') and prints the total wall clock time under
+# LABEL. Needs CMake 3.23 for sub-second timestamps.
+
+string(REPLACE "|" ";" command "${COMMAND}")
+string(REPLACE "|" ";" sources "${SOURCES}")
+
+string(TIMESTAMP start "%s%f")
+foreach(source ${sources})
+	execute_process(COMMAND ${command} ${source} -o ${source}.o RESULT_VARIABLE result)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "${LABEL}: compiling ${source} failed")
+	endif()
+endforeach()
+string(TIMESTAMP end "%s%f")
+
+math(EXPR total "(${end} - ${start}) / 1000")
+list(LENGTH sources count)
+message("${LABEL}: ${total} ms for ${count} translation units")
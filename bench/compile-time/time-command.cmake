@@ -0,0 +1,21 @@
+# Runs COMMAND (arguments separated by '|') REPEAT times and prints the mean
+# wall clock time under LABEL. Needs CMake 3.23 for sub-second timestamps.
+
+string(REPLACE "|" ";" command "${COMMAND}")
+if(NOT REPEAT)
+	set(REPEAT 3)
+endif()
+
+set(total 0)
+foreach(i RANGE 1 ${REPEAT})
+	string(TIMESTAMP start "%s%f")
+	execute_process(COMMAND ${command} RESULT_VARIABLE result)
+	string(TIMESTAMP end "%s%f")
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "${LABEL}: command failed")
+	endif()
+	math(EXPR total "${total} + (${end} - ${start}) / 1000")
+endforeach()
+
+math(EXPR mean "${total} / ${REPEAT}")
+message("${LABEL}: ${mean} ms")
@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <data-table.hpp>
+#include "bench.hpp"
+
+namespace {
+constexpr std::size_t rows = 250000; // 4 columns, so 1M cells
+
+struct Columns {
+	std::vector<std::int64_t> ids;
+	std::vector<std::string> nameStorage;
+	std::vector<std::string_view> names;
+	std::vector<double> prices;
+	std::vector<std::int64_t> quantities;
+};
+
+const Columns& columns() {
+	static const Columns data = [] {
+		Columns result;
+		for (std::size_t i = 0; i < rows; ++i) {
+			result.ids.push_back(static_cast<std::int64_t>(i));
+			result.nameStorage.push_back("Product " + std::to_string(i % 1000));
+			result.prices.push_back(static_cast<double>(i % 10000) / 100.0);
+			result.quantities.push_back(static_cast<std::int64_t>(i * 7 % 500));
+		}
+		result.names.assign(result.nameStorage.begin(), result.nameStorage.end());
+		return result;
+	}();
+	return data;
+}
+}
+
+WEB_BENCHMARK("data-table/1M cells from columns")
+{
+	const Columns& data = columns();
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		stream << Web::DataTable{
+			Web::Column{ "Id", std::span(data.ids) },
+			Web::Column{ "Name", std::span(data.names) },
+			Web::Column{ "Price", std::span(data.prices), Web::NumberFormat{ .precision = 2 } },
+			Web::Column{ "Quantity", std::span(data.quantities) }
+		};
+	}
+	state.setItemsPerIteration(rows * 4);
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
+
+WEB_BENCHMARK("data-table/1M cells as Tr and Td elements")
+{
+	const Columns& data = columns();
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		std::vector<Web::Tr> tableRows;
+		tableRows.reserve(rows);
+		for (std::size_t row = 0; row < rows; ++row) {
+			tableRows.push_back(Web::Tr{
+				Web::Td{ data.ids[row] },
+				Web::Td{ data.names[row] },
+				Web::Td{ Web::Number{ data.prices[row], Web::NumberFormat{ .precision = 2 } } },
+				Web::Td{ data.quantities[row] }
+			});
+		}
+		stream << Web::Table{
+			Web::Thead{ Web::Tr{ Web::Th{ "Id" }, Web::Th{ "Name" }, Web::Th{ "Price" }, Web::Th{ "Quantity" } } },
+			Web::Tbody{ std::move(tableRows) }
+		};
+	}
+	state.setItemsPerIteration(rows * 4);
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
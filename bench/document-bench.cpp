@@ -0,0 +1,129 @@
+#include <ostream>
+#include <vector>
+#include <document.hpp>
+#include "bench.hpp"
+
+namespace {
+constexpr std::size_t rows = 250000; // Four nodes per row, so a million nodes
+
+Web::Document buildDocument() {
+	Web::DocumentBuilder builder;
+	builder.reserve(rows * 4 + 1, rows, rows * 16);
+	builder.open<Web::Div>();
+	for (std::size_t i = 0; i < rows; ++i) {
+		builder.open<Web::Div>().attribute(Web::Class<"row">{});
+		builder.element<Web::P>("Row ", i);
+		builder.close();
+	}
+	builder.close();
+	return builder.finish();
+}
+}
+
+WEB_BENCHMARK("document/build 1M nodes")
+{
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		auto doc = buildDocument();
+		Bench::doNotOptimize(doc);
+	}
+	state.setItemsPerIteration(rows * 4);
+}
+
+WEB_BENCHMARK("document/render 1M nodes")
+{
+	const auto doc = buildDocument();
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		stream << doc;
+	}
+	state.setItemsPerIteration(rows * 4);
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
+
+WEB_BENCHMARK("document/nested elements 1M nodes")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		std::vector<Web::Div> divs;
+		divs.reserve(rows);
+		for (std::size_t r = 0; r < rows; ++r) {
+			divs.push_back(Web::Div{ Web::Attr{ Web::Class<"row">{} }, Web::P{ "Row ", r } });
+		}
+		stream << Web::Div{ std::move(divs) };
+	}
+	state.setItemsPerIteration(rows * 4);
+}
+
+namespace {
+constexpr std::size_t pageRows = 100000;
+
+// A 100k-row status page: each row has a unique id cell and a few cells
+// drawn from a small set of values
+Web::Document buildStatusPage(Web::DocumentBuilderOptions options) {
+	static constexpr const char* states[] = { "up", "up", "degraded", "down" };
+	Web::DocumentBuilder builder(options);
+	builder.open<Web::Table>();
+	for (std::size_t i = 0; i < pageRows; ++i) {
+		builder.open<Web::Tr>();
+		builder.element<Web::Td>(i);
+		builder.open<Web::Td>().attribute(Web::Class<"state">{});
+		builder.element<Web::Span>(states[i % 4]);
+		builder.close();
+		builder.open<Web::Td>().attribute(Web::Class<"region">{}).text(i % 8 < 4 ? "eu-west" : "us-east").close();
+		builder.element<Web::Td>("-");
+		builder.close();
+	}
+	builder.close();
+	return builder.finish();
+}
+
+// Bytes per iteration is the size of the document's tables, not of its output
+void benchmarkStatusPage(Bench::State& state, Web::DocumentBuilderOptions options) {
+	std::size_t memory = 0;
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		auto doc = buildStatusPage(options);
+		memory = doc.getMemoryUsage();
+		Bench::doNotOptimize(doc);
+	}
+	state.setItemsPerIteration(pageRows);
+	state.setBytesPerIteration(memory);
+}
+
+void benchmarkStatusPageRender(Bench::State& state, Web::DocumentBuilderOptions options) {
+	const auto doc = buildStatusPage(options);
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		stream << doc;
+	}
+	state.setItemsPerIteration(pageRows);
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
+}
+
+WEB_BENCHMARK("document/build 100k-row page")
+{
+	benchmarkStatusPage(state, {});
+}
+
+WEB_BENCHMARK("document/build 100k-row page deduplicated")
+{
+	benchmarkStatusPage(state, { .deduplicateSubtrees = true });
+}
+
+WEB_BENCHMARK("document/render 100k-row page")
+{
+	benchmarkStatusPageRender(state, {});
+}
+
+WEB_BENCHMARK("document/render 100k-row page deduplicated")
+{
+	benchmarkStatusPageRender(state, { .deduplicateSubtrees = true });
+}
+
+WEB_BENCHMARK("document/render 100k-row page cached")
+{
+	benchmarkStatusPageRender(state, { .deduplicateSubtrees = true, .cacheSharedSubtrees = true });
+}
@@ -0,0 +1,40 @@
+#include <ostream>
+#include <vector>
+#include <generator.hpp>
+#include "bench.hpp"
+
+namespace {
+constexpr int rows = 1000000;
+
+Web::Generator<Web::Tr> exportRows(int count) {
+	for (int i = 0; i < count; ++i) {
+		co_yield Web::Tr{ Web::Td{ i }, Web::Td{ i * 3 } };
+	}
+}
+}
+
+WEB_BENCHMARK("generator/1M rows streamed")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		stream << Web::Table{ Web::Tbody{ exportRows(rows) } };
+	}
+	state.setItemsPerIteration(rows);
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
+
+WEB_BENCHMARK("generator/1M rows collected in a vector")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		std::vector<Web::Tr> collected;
+		for (int row = 0; row < rows; ++row) {
+			collected.push_back(Web::Tr{ Web::Td{ row }, Web::Td{ row * 3 } });
+		}
+		stream << Web::Table{ Web::Tbody{ std::move(collected) } };
+	}
+	state.setItemsPerIteration(rows);
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
@@ -0,0 +1,53 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "bench.hpp"
+
+namespace {
+constexpr auto minimumDuration = std::chrono::milliseconds(200);
+
+double runFor(const Bench::Benchmark& benchmark, Bench::State& state) {
+	const auto start = std::chrono::steady_clock::now();
+	benchmark.function(state);
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - start).count();
+}
+
+void run(const Bench::Benchmark& benchmark) {
+	std::size_t iterations = 1;
+	for (;;) {
+		Bench::State state(iterations);
+		const double seconds = runFor(benchmark, state);
+		if (seconds >= std::chrono::duration<double>(minimumDuration).count() || iterations >= (std::size_t(1) << 40)) {
+			const double perIteration = seconds / static_cast<double>(iterations);
+			std::printf("%-48s %12zu iterations %14.1f ns/iter", benchmark.name.c_str(), iterations, perIteration * 1e9);
+			if (state.getBytesPerIteration() != 0) {
+				std::printf(" %10.1f MB/s", static_cast<double>(state.getBytesPerIteration()) / perIteration / 1e6);
+			}
+			if (state.getItemsPerIteration() != 0) {
+				std::printf(" %14.0f items/s", static_cast<double>(state.getItemsPerIteration()) / perIteration);
+			}
+			std::printf("\n");
+			return;
+		}
+		iterations = seconds <= 0.0 ? iterations * 10
+			: static_cast<std::size_t>(static_cast<double>(iterations) * 1.2 * std::chrono::duration<double>(minimumDuration).count() / seconds) + 1;
+	}
+}
+}
+
+// Runs every benchmark, or only those whose name contains one of the arguments
+int main(int argc, char** argv)
+{
+	std::printf("Built with %s\n", WEB_BENCH_SETTINGS);
+	for (const auto& benchmark : Bench::registry()) {
+		bool selected = argc < 2;
+		for (int i = 1; i < argc; ++i) {
+			selected = selected || std::strstr(benchmark.name.c_str(), argv[i]) != nullptr;
+		}
+		if (selected) {
+			run(benchmark);
+		}
+	}
+	return 0;
+}
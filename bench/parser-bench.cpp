@@ -0,0 +1,60 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <parser.hpp>
+#include "bench.hpp"
+
+namespace {
+// The partials in bench/corpus, or the directory named by WEB_BENCH_CORPUS
+const std::vector<std::string>& corpus() {
+	static const std::vector<std::string> partials = [] {
+		const char* overridden = std::getenv("WEB_BENCH_CORPUS");
+		const std::filesystem::path directory = overridden ? overridden : WEB_BENCH_CORPUS_DIR;
+
+		std::vector<std::string> files;
+		for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+			if (entry.is_regular_file()) {
+				std::ifstream file(entry.path(), std::ios::binary);
+				std::stringstream contents;
+				contents << file.rdbuf();
+				files.push_back(contents.str());
+			}
+		}
+		return files;
+	}();
+	return partials;
+}
+
+std::size_t corpusBytes() {
+	std::size_t bytes = 0;
+	for (const auto& partial : corpus()) {
+		bytes += partial.size();
+	}
+	return bytes;
+}
+}
+
+WEB_BENCHMARK("parser/validate corpus")
+{
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		for (const auto& partial : corpus()) {
+			const auto error = Web::validateHtml(partial);
+			Bench::doNotOptimize(error);
+		}
+	}
+	state.setBytesPerIteration(corpusBytes());
+}
+
+WEB_BENCHMARK("parser/parse corpus into documents")
+{
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		for (const auto& partial : corpus()) {
+			auto doc = Web::parseHtml(partial);
+			Bench::doNotOptimize(doc);
+		}
+	}
+	state.setBytesPerIteration(corpusBytes());
+}
@@ -0,0 +1,52 @@
+#include <ostream>
+#include <string>
+#include <shared.hpp>
+#include "bench.hpp"
+
+namespace {
+Web::Header buildHeader() {
+	return Web::Header{
+		Web::Attr{ Web::Class<"site-header">{} },
+		Web::H1{ "Example Store" },
+		Web::Nav{ Web::Ul{
+			Web::Li{ Web::A{ "Home" } }, Web::Li{ Web::A{ "Products" } }, Web::Li{ Web::A{ "Offers" } },
+			Web::Li{ Web::A{ "Support" } }, Web::Li{ Web::A{ "Account" } }, Web::Li{ Web::A{ "Basket" } }
+		} }
+	};
+}
+
+Web::Footer buildFooter() {
+	return Web::Footer{
+		Web::Ul{
+			Web::Li{ Web::A{ "Privacy" } }, Web::Li{ Web::A{ "Terms" } }, Web::Li{ Web::A{ "Cookies" } },
+			Web::Li{ Web::A{ "Contact" } }, Web::Li{ Web::A{ "Careers" } }
+		},
+		Web::P{ "(c) Example Store. All rights reserved." }
+	};
+}
+
+const Web::Shared sharedHeader{ buildHeader() };
+const Web::Shared sharedFooter{ buildFooter() };
+}
+
+WEB_BENCHMARK("shared/site chrome built per request")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	const std::string title = "Product";
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		stream << Web::Html{ Web::Body{ buildHeader(), Web::Main{ Web::H2{ title }, Web::P{ "Item ", i } }, buildFooter() } };
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
+
+WEB_BENCHMARK("shared/site chrome as Shared subtrees")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	const std::string title = "Product";
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		stream << Web::Html{ Web::Body{ sharedHeader, Web::Main{ Web::H2{ title }, Web::P{ "Item ", i } }, sharedFooter } };
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
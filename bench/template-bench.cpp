@@ -0,0 +1,105 @@
+#include <ostream>
+#include <string>
+#include <vector>
+#include <template.hpp>
+#include "bench.hpp"
+
+namespace {
+const std::vector<std::string> names = {
+	"John", "Jane", "Eric", "Alice", "Bob", "Carol", "Dave", "Erin", "Frank", "Grace"
+};
+
+Web::Html buildPage(const std::string& title, int count, const std::vector<std::string>& people) {
+	std::vector<Web::P> paragraphs;
+	paragraphs.reserve(people.size());
+	for (const auto& name : people) {
+		paragraphs.push_back(Web::P{ name });
+	}
+
+	return Web::Html {
+		Web::Body {
+			Web::H1{ title },
+			Web::Div{ Web::Attr{ Web::Class<"summary">{} }, Web::P{ "Visitors: ", count } },
+			Web::Div{ std::move(paragraphs) },
+			Web::P{ "Footer text" }
+		}
+	};
+}
+
+const Web::Template<std::string, int, std::vector<Web::P>> page{
+	Web::Html {
+		Web::Body {
+			Web::H1{ Web::Slot<0, std::string>{} },
+			Web::Div{ Web::Attr{ Web::Class<"summary">{} }, Web::P{ "Visitors: ", Web::Slot<1, int>{} } },
+			Web::Div{ Web::Slot<2, std::vector<Web::P>>{} },
+			Web::P{ "Footer text" }
+		}
+	}
+};
+
+// A template that only takes plain data, so rendering builds no elements at all
+const Web::Template<std::string, int> summary{
+	Web::Html {
+		Web::Body {
+			Web::H1{ Web::Slot<0, std::string>{} },
+			Web::Div{ Web::Attr{ Web::Class<"summary">{} }, Web::P{ "Visitors: ", Web::Slot<1, int>{} } },
+			Web::P{ "Footer text" }
+		}
+	}
+};
+}
+
+WEB_BENCHMARK("template/tree built per request")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	const std::string title = "Page title";
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		stream << buildPage(title, static_cast<int>(i), names);
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
+
+WEB_BENCHMARK("template/precompiled with element slot")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	const std::string title = "Page title";
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		std::vector<Web::P> paragraphs;
+		paragraphs.reserve(names.size());
+		for (const auto& name : names) {
+			paragraphs.push_back(Web::P{ name });
+		}
+		page.render(stream, title, static_cast<int>(i), paragraphs);
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
+
+WEB_BENCHMARK("template/tree built per request (no list)")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	const std::string title = "Page title";
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		stream << Web::Html {
+			Web::Body {
+				Web::H1{ title },
+				Web::Div{ Web::Attr{ Web::Class<"summary">{} }, Web::P{ "Visitors: ", static_cast<int>(i) } },
+				Web::P{ "Footer text" }
+			}
+		};
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
+
+WEB_BENCHMARK("template/precompiled (no list)")
+{
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	const std::string title = "Page title";
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		summary.render(stream, title, static_cast<int>(i));
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
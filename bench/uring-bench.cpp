@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <uring.hpp>
+#include <web.hpp>
+#include "bench.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+const Web::Ul& page() {
+	static const Web::Ul list = [] {
+		std::vector<Web::Li> items;
+		for (int i = 0; i < 50000; ++i) {
+			items.push_back(Web::Li{ "Exported row ", i });
+		}
+		return Web::Ul{ std::move(items) };
+	}();
+	return list;
+}
+
+// A scratch file rewritten from the start on every iteration
+class ScratchFile {
+	std::string path = "/tmp/web-uring-bench-XXXXXX";
+public:
+	int fd;
+	ScratchFile() :
+		fd(::mkstemp(path.data()))
+	{}
+	~ScratchFile() {
+		::close(fd);
+		::unlink(path.c_str());
+	}
+};
+
+std::size_t pageSize() {
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	stream << page();
+	return buffer.getCount();
+}
+
+void renderPages(Bench::State& state, int fd, const Web::UringOptions& options, bool rewind) {
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		if (rewind) {
+			::lseek(fd, 0, SEEK_SET);
+		}
+		Web::UringBuffer buffer(fd, options);
+		std::ostream stream(&buffer);
+		stream << page() << std::flush;
+	}
+	state.setBytesPerIteration(pageSize());
+}
+
+void renderToFile(Bench::State& state, Web::UringOptions options) {
+	ScratchFile file;
+	renderPages(state, file.fd, options, true);
+}
+
+void renderToNull(Bench::State& state, Web::UringOptions options) {
+	const int fd = ::open("/dev/null", O_WRONLY);
+	renderPages(state, fd, options, false);
+	::close(fd);
+}
+
+constexpr Web::UringOptions smallBuffers{ .bufferCount = 16, .bufferSize = 4096, .batchSize = 8 };
+}
+
+// The same buffers either way; only how they reach the kernel differs
+
+WEB_BENCHMARK("uring/1MB page to a file with io_uring")
+{
+	renderToFile(state, {});
+}
+
+WEB_BENCHMARK("uring/1MB page to a file with write")
+{
+	renderToFile(state, { .forceFallback = true });
+}
+
+WEB_BENCHMARK("uring/1MB page to a file with io_uring, 4KB buffers")
+{
+	renderToFile(state, smallBuffers);
+}
+
+WEB_BENCHMARK("uring/1MB page to a file with write, 4KB buffers")
+{
+	auto options = smallBuffers;
+	options.forceFallback = true;
+	renderToFile(state, options);
+}
+
+WEB_BENCHMARK("uring/1MB page to /dev/null with io_uring")
+{
+	renderToNull(state, {});
+}
+
+WEB_BENCHMARK("uring/1MB page to /dev/null with write")
+{
+	renderToNull(state, { .forceFallback = true });
+}
+#endif
@@ -0,0 +1,35 @@
+#include <ostream>
+#include <string>
+#include <vector>
+#include <web.hpp>
+#include "bench.hpp"
+
+// Built twice: web-bench renders with runtime validation compiled out, as in a
+// release build, and web-bench-validate with WEB_VALIDATE=1 to show its cost
+namespace {
+const std::string label = Web::validationEnabled ? " [WEB_VALIDATE=1]" : " [WEB_VALIDATE=0]";
+
+Web::Html buildPage() {
+	std::vector<Web::Li> items;
+	for (int i = 0; i < 100; ++i) {
+		items.push_back(Web::Li{ Web::Attr{ Web::Id{ "item-" + std::to_string(i) }, Web::Class{ "item" } }, "Item ", i });
+	}
+	return Web::Html {
+		Web::Body {
+			Web::H1{ Web::Attr{ Web::Id<"title">{} }, "Items" },
+			Web::Div{ Web::Ul{ std::move(items) } }
+		}
+	};
+}
+}
+
+WEB_BENCHMARK("validation/render page with 100 ids" + label)
+{
+	const auto page = buildPage();
+	Bench::NullBuffer buffer;
+	std::ostream stream(&buffer);
+	for (std::size_t i = 0; i < state.getIterations(); ++i) {
+		stream << page;
+	}
+	state.setBytesPerIteration(buffer.getCount() / state.getIterations());
+}
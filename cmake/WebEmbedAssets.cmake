@@ -0,0 +1,50 @@
+# web_embed_assets(<target> <files>...)
+#
+# Generates a header per file containing the file as a constexpr Web::Asset and
+# makes the headers available to <target>. A file named footer.html becomes
+#
+#   #include <web-assets/footer_html.hpp>
+#   Web::Assets::footer_html // constexpr Web::Asset
+#
+# The headers are regenerated whenever the files change. Names come from the
+# file name alone, so embedding two files with the same name into one target,
+# e.g. a/logo.svg and b/logo.svg, is an error.
+
+set(WEB_EMBED_ASSET_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/web-embed-asset.cmake)
+
+function(web_embed_assets target)
+	set(output_dir ${CMAKE_CURRENT_BINARY_DIR}/web-assets-${target})
+
+	foreach(file ${ARGN})
+		get_filename_component(input ${file} ABSOLUTE)
+		get_filename_component(file_name ${file} NAME)
+		string(MAKE_C_IDENTIFIER ${file_name} identifier)
+		set(output ${output_dir}/web-assets/${identifier}.hpp)
+
+		get_property(embedded_identifiers TARGET ${target} PROPERTY WEB_EMBEDDED_ASSET_IDENTIFIERS)
+		get_property(embedded_inputs TARGET ${target} PROPERTY WEB_EMBEDDED_ASSET_INPUTS)
+		list(FIND embedded_identifiers ${identifier} existing)
+		if (NOT existing EQUAL -1)
+			list(GET embedded_inputs ${existing} existing_input)
+			message(FATAL_ERROR "web_embed_assets: ${input} and ${existing_input} would both embed as Web::Assets::${identifier} in ${target}")
+		endif()
+		set_property(TARGET ${target} APPEND PROPERTY WEB_EMBEDDED_ASSET_IDENTIFIERS ${identifier})
+		set_property(TARGET ${target} APPEND PROPERTY WEB_EMBEDDED_ASSET_INPUTS ${input})
+
+		add_custom_command(
+			OUTPUT ${output}
+			COMMAND ${CMAKE_COMMAND}
+				-DINPUT=${input}
+				-DOUTPUT=${output}
+				-DNAME=${file_name}
+				-DIDENTIFIER=${identifier}
+				-P ${WEB_EMBED_ASSET_SCRIPT}
+			DEPENDS ${input} ${WEB_EMBED_ASSET_SCRIPT}
+			COMMENT "Embedding ${file_name}"
+			VERBATIM
+		)
+		target_sources(${target} PRIVATE ${output})
+	endforeach()
+
+	target_include_directories(${target} PRIVATE ${output_dir})
+endfunction()
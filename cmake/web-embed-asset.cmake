@@ -0,0 +1,40 @@
+# Writes INPUT as a constexpr Web::Asset named IDENTIFIER to the header OUTPUT.
+# Run by web_embed_assets() at build time.
+
+file(READ ${INPUT} contents HEX)
+file(SHA256 ${INPUT} sha256)
+string(SUBSTRING ${sha256} 0 16 hash)
+string(LENGTH "${contents}" hex_length)
+math(EXPR size "${hex_length} / 2")
+
+# One string literal per 32 bytes, every byte as a hex escape
+set(literal "")
+set(offset 0)
+while(offset LESS hex_length)
+	string(SUBSTRING "${contents}" ${offset} 64 chunk)
+	string(REGEX REPLACE "([0-9a-f][0-9a-f])" "\\\\x\\1" chunk "${chunk}")
+	string(APPEND literal "\t\t\"${chunk}\"\n")
+	math(EXPR offset "${offset} + 64")
+endwhile()
+if(size EQUAL 0)
+	set(literal "\t\t\"\"\n")
+endif()
+
+file(WRITE ${OUTPUT}.tmp
+"// Generated by web_embed_assets() from ${NAME}. Do not edit.
+#pragma once
+#include <asset.hpp>
+
+namespace Web::Assets {
+	inline constexpr char ${IDENTIFIER}_data[] =
+${literal}\t\t;
+
+	inline constexpr Web::Asset ${IDENTIFIER}{
+		\"${NAME}\",
+		std::string_view(${IDENTIFIER}_data, ${size}),
+		0x${hash}ull
+	};
+}
+")
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different ${OUTPUT}.tmp ${OUTPUT})
+file(REMOVE ${OUTPUT}.tmp)
@@ -32,6 +32,7 @@ int main()
 			Web::H1{ "This is our title" },
 			Web::Br{},
 			Web::P { "Hello World" },
+			//Web::P { Web::Div{} }, // This will not compile: <p> only permits phrasing content
 			createNameList({"John", "Jane", "Eric"})
 		}
 	};
@@ -47,6 +48,17 @@ int main()
 
 	std::cout << d << "\n";
 
+	// Attributes known at compile time are folded into the opening tag
+	auto centered = Web::Div{
+		Web::Attr {
+			Web::Class<"center">{},
+			//Web::Class{ "thingy" }, // This will not compile if uncommented
+			Web::Id<"main">{}
+		},
+		Web::P{ "Centered" }
+	};
+	std::cout << centered << "\n";
+
 	std::cout << "Press enter to close";
 	std::cin.get();
 	return 0;
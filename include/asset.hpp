@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+
+namespace Web {
+
+	// A file embedded into the binary at build time by web_embed_assets(). Assets
+	// are constexpr, cost a few words to copy into a tree, and render their bytes
+	// verbatim. Inside a Template they fold into the surrounding static markup.
+	class Asset {
+		std::string_view name;
+		std::string_view bytes;
+		std::uint64_t hash;
+	public:
+		constexpr Asset(std::string_view name, std::string_view bytes, std::uint64_t hash) :
+			name(name),
+			bytes(bytes),
+			hash(hash)
+		{}
+
+		// The file name the asset was generated from
+		constexpr std::string_view getName() const {
+			return name;
+		}
+		constexpr std::string_view view() const {
+			return bytes;
+		}
+		constexpr std::size_t size() const {
+			return bytes.size();
+		}
+		// The first 64 bits of the file's SHA-256, e.g. for ETags or cache keys
+		constexpr std::uint64_t getHash() const {
+			return hash;
+		}
+	};
+
+	inline std::ostream& operator<<(std::ostream& stream, const Asset& asset) {
+		return stream.write(asset.view().data(), static_cast<std::streamsize>(asset.size()));
+	}
+}
@@ -0,0 +1,493 @@
+#pragma once
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "render.hpp"
+#include "web.hpp"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+
+namespace Web {
+
+	namespace detail {
+		template <typename T>
+		struct TaskResult {
+			std::optional<T> value;
+
+			template <typename U>
+			void return_value(U&& result) {
+				value.emplace(std::forward<U>(result));
+			}
+			T take() {
+				return std::move(*value);
+			}
+		};
+		template <>
+		struct TaskResult<void> {
+			void return_void() noexcept {}
+			void take() {}
+		};
+	}
+
+	// A lazily started coroutine that resumes whoever awaits it when it finishes
+	template <typename T = void>
+	class Task {
+	public:
+		struct promise_type : detail::TaskResult<T> {
+			std::coroutine_handle<> continuation = std::noop_coroutine();
+			std::exception_ptr error;
+
+			Task get_return_object() {
+				return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+			std::suspend_always initial_suspend() noexcept {
+				return {};
+			}
+			auto final_suspend() noexcept {
+				struct ResumeContinuation {
+					bool await_ready() noexcept {
+						return false;
+					}
+					std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+						return handle.promise().continuation;
+					}
+					void await_resume() noexcept {}
+				};
+				return ResumeContinuation{};
+			}
+			void unhandled_exception() {
+				error = std::current_exception();
+			}
+		};
+
+		Task(Task&& other) noexcept :
+			handle(std::exchange(other.handle, nullptr))
+		{}
+		Task& operator=(Task&& other) noexcept {
+			if (this != &other) {
+				if (handle) {
+					handle.destroy();
+				}
+				handle = std::exchange(other.handle, nullptr);
+			}
+			return *this;
+		}
+		~Task() {
+			if (handle) {
+				handle.destroy();
+			}
+		}
+
+		bool isDone() const {
+			return !handle || handle.done();
+		}
+
+		// Starts the task without waiting for it, e.g. from an EventLoop
+		void start() {
+			handle.resume();
+		}
+
+		// Returns the result of a finished task, rethrowing its exception
+		T getResult() {
+			assert(handle.done());
+			if (handle.promise().error) {
+				std::rethrow_exception(handle.promise().error);
+			}
+			return handle.promise().take();
+		}
+
+		auto operator co_await() && noexcept {
+			struct Awaiter {
+				std::coroutine_handle<promise_type> handle;
+
+				bool await_ready() noexcept {
+					return handle.done();
+				}
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+					handle.promise().continuation = awaiting;
+					return handle;
+				}
+				T await_resume() {
+					if (handle.promise().error) {
+						std::rethrow_exception(handle.promise().error);
+					}
+					return handle.promise().take();
+				}
+			};
+			return Awaiter{ handle };
+		}
+
+	private:
+		std::coroutine_handle<promise_type> handle;
+
+		explicit Task(std::coroutine_handle<promise_type> handle) :
+			handle(handle)
+		{}
+	};
+
+	// Where an asynchronous render writes its output. write() takes the bytes
+	// and only suspends the render when the sink has too much queued, e.g.
+	//
+	//   if (!co_await sink.write(bytes)) { /* the sink has failed */ }
+	class AsyncSink {
+	public:
+		virtual ~AsyncSink() = default;
+
+		class Awaiter {
+			AsyncSink& sink;
+			std::string_view bytes;
+			bool draining;
+		public:
+			Awaiter(AsyncSink& sink, std::string_view bytes, bool draining) :
+				sink(sink),
+				bytes(bytes),
+				draining(draining)
+			{}
+			bool await_ready() {
+				return draining ? sink.isDrained() : sink.accept(bytes);
+			}
+			void await_suspend(std::coroutine_handle<> waiter) {
+				sink.waitForSpace(waiter, draining);
+			}
+			bool await_resume() const {
+				return !sink.hasFailed();
+			}
+		};
+
+		// Queues bytes, which may be reused as soon as this returns an awaiter.
+		// Awaiting it gives false if the sink has failed.
+		Awaiter write(std::string_view bytes) {
+			return Awaiter(*this, bytes, false);
+		}
+		// Waits until everything queued has been written
+		Awaiter drain() {
+			return Awaiter(*this, {}, true);
+		}
+
+		virtual bool hasFailed() const = 0;
+
+	protected:
+		// Takes all of bytes. Returns false when the writer should wait for space.
+		virtual bool accept(std::string_view bytes) = 0;
+		virtual bool isDrained() const = 0;
+		// Resumes waiter once there is space again, or everything is written when draining
+		virtual void waitForSpace(std::coroutine_handle<> waiter, bool draining) = 0;
+	};
+
+	// A sink that appends to a string and never has to wait
+	class StringSink : public AsyncSink {
+		std::string& target;
+	public:
+		explicit StringSink(std::string& target) :
+			target(target)
+		{}
+		bool hasFailed() const override {
+			return false;
+		}
+	protected:
+		bool accept(std::string_view bytes) override {
+			target += bytes;
+			return true;
+		}
+		bool isDrained() const override {
+			return true;
+		}
+		void waitForSpace(std::coroutine_handle<> waiter, bool /*draining*/) override {
+			waiter.resume();
+		}
+	};
+
+	struct AsyncRenderOptions {
+		// Output is handed to the sink in chunks of about this size
+		std::size_t chunkSize = 16 * 1024;
+	};
+
+	// Renders node into sink, suspending whenever the sink is full. The node
+	// must outlive the task. Renders that interleave on one thread are not
+	// checked by WEB_VALIDATE or recorded by the profiler, since both follow
+	// the render stack of the thread.
+	template <typename T>
+	Task<bool> renderAsync(AsyncSink& sink, const T& node, AsyncRenderOptions options = {}) {
+		struct Frame {
+			NodeRef node;
+			std::size_t nextChild;
+		};
+		std::vector<Frame> stack;
+		std::string chunk;
+		chunk.reserve(options.chunkSize + options.chunkSize / 4);
+		StringBuffer buffer(chunk);
+		std::ostream stream(&buffer);
+
+		const auto enter = [&](const NodeRef& ref) {
+			if (ref.open) {
+				ref.open(stream, ref.object);
+			}
+			if (ref.child) {
+				stack.push_back(Frame{ ref, 0 });
+			}
+		};
+
+		enter(MakeNodeRef(node));
+		while (!stack.empty()) {
+			Frame& frame = stack.back();
+			if (const auto child = frame.node.child(frame.node.object, frame.nextChild++)) {
+				enter(*child);
+			}
+			else {
+				if (frame.node.close) {
+					frame.node.close(stream, frame.node.object);
+				}
+				stack.pop_back();
+			}
+
+			if (buffer.size() >= options.chunkSize) {
+				if (!co_await sink.write(buffer.view())) {
+					co_return false;
+				}
+				buffer.clear();
+			}
+		}
+
+		if (!co_await sink.write(buffer.view())) {
+			co_return false;
+		}
+		co_return co_await sink.drain();
+	}
+
+#ifndef _WIN32
+	class FdSink;
+
+	// Runs tasks on the current thread, waiting in poll() while every task is
+	// blocked on a sink, e.g.
+	//
+	//   Web::EventLoop loop;
+	//   Web::FdSink client(loop, fd);
+	//   loop.spawn(Web::renderAsync(client, page));
+	//   loop.run();
+	class EventLoop {
+		struct Watch {
+			int fd;
+			void (*onWritable)(void*);
+			void* context;
+		};
+
+		std::vector<Task<>> tasks;
+		std::vector<Watch> watches;
+
+	public:
+		template <typename T>
+		void spawn(Task<T> task) {
+			tasks.push_back([](Task<T> inner) -> Task<> {
+				co_await std::move(inner);
+			}(std::move(task)));
+			tasks.back().start();
+		}
+
+		// Calls onWritable(context) once when fd becomes writable
+		void watchWritable(int fd, void (*onWritable)(void*), void* context) {
+			watches.push_back(Watch{ fd, onWritable, context });
+		}
+
+		// Runs until every spawned task has finished, rethrowing the first
+		// exception one of them ended with. Throws std::logic_error when tasks
+		// are left waiting on something other than a sink, as nothing could
+		// resume them.
+		void run() {
+			std::vector<pollfd> fds;
+			std::vector<Watch> ready;
+			while (!tasks.empty()) {
+				for (auto it = tasks.begin(); it != tasks.end();) {
+					if (it->isDone()) {
+						Task<> done = std::move(*it);
+						it = tasks.erase(it);
+						done.getResult();
+					}
+					else {
+						++it;
+					}
+				}
+				if (tasks.empty()) {
+					break;
+				}
+				if (watches.empty()) {
+					throw std::logic_error("EventLoop tasks are waiting on something other than a sink");
+				}
+
+				fds.clear();
+				for (const Watch& watch : watches) {
+					fds.push_back(pollfd{ watch.fd, POLLOUT, 0 });
+				}
+				if (::poll(fds.data(), fds.size(), -1) < 0) {
+					if (errno == EINTR) {
+						continue;
+					}
+					throw std::system_error(errno, std::generic_category(), "poll");
+				}
+
+				// Callbacks may add watches, so take the ready ones out first
+				ready.clear();
+				std::size_t kept = 0;
+				for (std::size_t i = 0; i < fds.size(); ++i) {
+					if (fds[i].revents != 0) {
+						ready.push_back(watches[i]);
+					}
+					else {
+						watches[kept++] = watches[i];
+					}
+				}
+				watches.resize(kept);
+				for (const Watch& watch : ready) {
+					watch.onWritable(watch.context);
+				}
+			}
+		}
+	};
+
+	struct FdSinkOptions {
+		// Writers wait once this many bytes are queued
+		std::size_t highWatermark = 64 * 1024;
+		// and resume once the queue is back down to this
+		std::size_t lowWatermark = 16 * 1024;
+	};
+
+	// A sink for a socket or pipe. The descriptor is switched to non-blocking;
+	// bytes the kernel does not take at once are queued and written when poll()
+	// reports the descriptor writable. The sink does not close the descriptor.
+	// Writing to a pipe whose reader has gone raises SIGPIPE, as write() does,
+	// unless the program ignores it.
+	class FdSink : public AsyncSink {
+		EventLoop& loop;
+		int fd;
+		FdSinkOptions options;
+		std::string queue;
+		std::size_t queueStart = 0;
+		std::coroutine_handle<> waiter;
+		bool draining = false;
+		bool failed = false;
+		bool isSocket = true; // Until send() says otherwise
+		std::size_t waits = 0;
+
+#ifdef MSG_NOSIGNAL
+		// A closed peer fails the render instead of raising SIGPIPE
+		static constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+		static constexpr int sendFlags = 0;
+#endif
+
+		std::size_t queued() const {
+			return queue.size() - queueStart;
+		}
+
+		// Writes as much as the descriptor takes without blocking
+		std::size_t writeSome(const char* data, std::size_t size) {
+			std::size_t total = 0;
+			while (total < size && !failed) {
+				const ssize_t written = isSocket
+					? ::send(fd, data + total, size - total, sendFlags)
+					: ::write(fd, data + total, size - total);
+				if (written < 0 && isSocket && errno == ENOTSOCK) {
+					isSocket = false;
+					continue;
+				}
+				if (written >= 0) {
+					total += static_cast<std::size_t>(written);
+				}
+				else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+					break;
+				}
+				else if (errno != EINTR) {
+					failed = true;
+				}
+			}
+			return total;
+		}
+
+		void writeQueued() {
+			queueStart += writeSome(queue.data() + queueStart, queued());
+			if (queued() == 0 || failed) {
+				queue.clear();
+				queueStart = 0;
+			}
+			else if (queueStart > queued()) {
+				// Keep the queue bounded while it never fully drains
+				queue.erase(0, queueStart);
+				queueStart = 0;
+			}
+		}
+
+		static void onWritable(void* context) {
+			auto& sink = *static_cast<FdSink*>(context);
+			sink.writeQueued();
+			const std::size_t target = sink.draining ? 0 : sink.options.lowWatermark;
+			if (sink.failed || sink.queued() <= target) {
+				std::exchange(sink.waiter, nullptr).resume();
+			}
+			else {
+				sink.loop.watchWritable(sink.fd, onWritable, &sink);
+			}
+		}
+
+	public:
+		FdSink(EventLoop& loop, int fd, FdSinkOptions options = {}) :
+			loop(loop),
+			fd(fd),
+			options(options)
+		{
+			const int flags = ::fcntl(fd, F_GETFL);
+			failed = flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0;
+		}
+		FdSink(const FdSink&) = delete;
+		FdSink& operator=(const FdSink&) = delete;
+
+		bool hasFailed() const override {
+			return failed;
+		}
+
+		// How many times a writer had to wait for the descriptor
+		std::size_t getWaitCount() const {
+			return waits;
+		}
+
+	protected:
+		bool accept(std::string_view bytes) override {
+			if (failed) {
+				return true;
+			}
+			if (queued() == 0) {
+				// Try the descriptor first so bytes a fast reader takes are never copied
+				bytes.remove_prefix(writeSome(bytes.data(), bytes.size()));
+			}
+			queue.append(bytes);
+			return failed || queued() < options.highWatermark;
+		}
+
+		bool isDrained() const override {
+			return failed || queued() == 0;
+		}
+
+		void waitForSpace(std::coroutine_handle<> handle, bool drain) override {
+			assert(!waiter); // One writer at a time
+			++waits;
+			waiter = handle;
+			draining = drain;
+			loop.watchWritable(fd, onWritable, this);
+		}
+	};
+#endif
+}
@@ -0,0 +1,451 @@
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "web.hpp"
+
+
+namespace Web {
+
+	// The kind of value an attribute takes, checked when the attribute is built
+	enum class AttributeType : std::uint8_t {
+		Text,
+		Number,
+		Boolean, // Written as the bare name when true, left out when false
+		Url
+	};
+
+	struct StandardAttribute {
+		std::string_view name;
+		AttributeType type;
+	};
+
+	// The attributes Attribute<Name> accepts besides data-*. class and id have
+	// their own types, Class and Id.
+	inline constexpr StandardAttribute standardAttributes[] = {
+		{ "accept", AttributeType::Text }, { "accept-charset", AttributeType::Text },
+		{ "accesskey", AttributeType::Text }, { "action", AttributeType::Url },
+		{ "allow", AttributeType::Text }, { "alt", AttributeType::Text },
+		{ "aria-checked", AttributeType::Text }, { "aria-controls", AttributeType::Text },
+		{ "aria-current", AttributeType::Text }, { "aria-describedby", AttributeType::Text },
+		{ "aria-expanded", AttributeType::Text }, { "aria-hidden", AttributeType::Text },
+		{ "aria-label", AttributeType::Text }, { "aria-labelledby", AttributeType::Text },
+		{ "aria-live", AttributeType::Text }, { "async", AttributeType::Boolean },
+		{ "autocomplete", AttributeType::Text }, { "autofocus", AttributeType::Boolean },
+		{ "charset", AttributeType::Text }, { "checked", AttributeType::Boolean },
+		{ "cite", AttributeType::Url }, { "cols", AttributeType::Number },
+		{ "colspan", AttributeType::Number }, { "content", AttributeType::Text },
+		{ "contenteditable", AttributeType::Text }, { "crossorigin", AttributeType::Text },
+		{ "datetime", AttributeType::Text }, { "defer", AttributeType::Boolean },
+		{ "dir", AttributeType::Text }, { "disabled", AttributeType::Boolean },
+		{ "download", AttributeType::Text }, { "draggable", AttributeType::Text },
+		{ "enctype", AttributeType::Text }, { "for", AttributeType::Text },
+		{ "form", AttributeType::Text }, { "formaction", AttributeType::Url },
+		{ "headers", AttributeType::Text }, { "height", AttributeType::Number },
+		{ "hidden", AttributeType::Boolean }, { "high", AttributeType::Number },
+		{ "href", AttributeType::Url }, { "hreflang", AttributeType::Text },
+		{ "http-equiv", AttributeType::Text }, { "integrity", AttributeType::Text },
+		{ "lang", AttributeType::Text }, { "list", AttributeType::Text },
+		{ "loading", AttributeType::Text }, { "low", AttributeType::Number },
+		{ "max", AttributeType::Text }, { "maxlength", AttributeType::Number },
+		{ "media", AttributeType::Text }, { "method", AttributeType::Text },
+		{ "min", AttributeType::Text }, { "minlength", AttributeType::Number },
+		{ "multiple", AttributeType::Boolean }, { "name", AttributeType::Text },
+		{ "novalidate", AttributeType::Boolean }, { "open", AttributeType::Boolean },
+		{ "optimum", AttributeType::Number }, { "pattern", AttributeType::Text },
+		{ "placeholder", AttributeType::Text }, { "poster", AttributeType::Url },
+		{ "readonly", AttributeType::Boolean }, { "referrerpolicy", AttributeType::Text },
+		{ "rel", AttributeType::Text }, { "required", AttributeType::Boolean },
+		{ "reversed", AttributeType::Boolean }, { "role", AttributeType::Text },
+		{ "rows", AttributeType::Number }, { "rowspan", AttributeType::Number },
+		{ "sandbox", AttributeType::Text }, { "scope", AttributeType::Text },
+		{ "selected", AttributeType::Boolean }, { "size", AttributeType::Number },
+		{ "sizes", AttributeType::Text }, { "span", AttributeType::Number },
+		{ "src", AttributeType::Url }, { "srcset", AttributeType::Text },
+		{ "start", AttributeType::Number }, { "step", AttributeType::Text },
+		{ "style", AttributeType::Text }, { "tabindex", AttributeType::Number },
+		{ "target", AttributeType::Text }, { "title", AttributeType::Text },
+		{ "translate", AttributeType::Text }, { "type", AttributeType::Text },
+		{ "value", AttributeType::Text }, { "width", AttributeType::Number },
+		{ "wrap", AttributeType::Text }
+	};
+	inline constexpr std::size_t standardAttributeCount = std::size(standardAttributes);
+
+	namespace detail {
+		constexpr std::uint32_t hashAttributeName(std::string_view name, std::uint32_t seed) {
+			std::uint32_t hash = 2166136261u ^ seed;
+			for (const char c : name) {
+				hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+			}
+			hash ^= hash >> 16;
+			hash *= 0x7feb352du;
+			hash ^= hash >> 15;
+			return hash;
+		}
+
+		// A perfect hash of the standard names: the first seed, found at compile
+		// time, for which no two names share a slot
+		struct AttributeTable {
+			static constexpr std::size_t slotCount = 1024;
+			static_assert(standardAttributeCount < 255, "Slots hold an index + 1 in a byte");
+
+			std::uint32_t seed = 0;
+			std::array<std::uint8_t, slotCount> slots{}; // index + 1, or 0 when empty
+
+			static constexpr std::size_t slotFor(std::string_view name, std::uint32_t seed) {
+				return hashAttributeName(name, seed) & (slotCount - 1);
+			}
+		};
+
+		inline constexpr AttributeTable attributeTable = [] {
+			AttributeTable table;
+			for (;; ++table.seed) {
+				table.slots = {};
+				bool collided = false;
+				for (std::size_t i = 0; i < standardAttributeCount && !collided; ++i) {
+					auto& slot = table.slots[AttributeTable::slotFor(standardAttributes[i].name, table.seed)];
+					collided = slot != 0;
+					slot = static_cast<std::uint8_t>(i + 1);
+				}
+				if (!collided) {
+					return table;
+				}
+			}
+		}();
+
+		// " name=\"" for each standard attribute, or " name" for boolean ones,
+		// back to back
+		constexpr std::size_t attributePrefixBytes() {
+			std::size_t bytes = 0;
+			for (const auto& attribute : standardAttributes) {
+				bytes += 1 + attribute.name.size() + (attribute.type == AttributeType::Boolean ? 0 : 2);
+			}
+			return bytes;
+		}
+
+		struct AttributePrefixes {
+			std::array<char, attributePrefixBytes()> bytes{};
+			std::array<std::uint16_t, standardAttributeCount + 1> offsets{};
+		};
+
+		inline constexpr AttributePrefixes attributePrefixes = [] {
+			AttributePrefixes prefixes;
+			std::size_t offset = 0;
+			const auto append = [&](std::string_view text) {
+				for (const char c : text) {
+					prefixes.bytes[offset++] = c;
+				}
+			};
+			for (std::size_t i = 0; i < standardAttributeCount; ++i) {
+				prefixes.offsets[i] = static_cast<std::uint16_t>(offset);
+				append(" ");
+				append(standardAttributes[i].name);
+				if (standardAttributes[i].type != AttributeType::Boolean) {
+					append("=\"");
+				}
+			}
+			prefixes.offsets[standardAttributeCount] = static_cast<std::uint16_t>(offset);
+			return prefixes;
+		}();
+	}
+
+	// The index of a standard attribute in standardAttributes, found with one
+	// probe of a perfect hash table
+	constexpr std::optional<std::size_t> findStandardAttribute(std::string_view name) {
+		const std::uint8_t slot = detail::attributeTable.slots[
+			detail::AttributeTable::slotFor(name, detail::attributeTable.seed)];
+		if (slot != 0 && standardAttributes[slot - 1].name == name) {
+			return static_cast<std::size_t>(slot - 1);
+		}
+		return std::nullopt;
+	}
+
+	// " name=\"", or " name" for boolean attributes
+	constexpr std::string_view standardAttributePrefix(std::size_t index) {
+		const auto& offsets = detail::attributePrefixes.offsets;
+		return std::string_view(detail::attributePrefixes.bytes.data() + offsets[index],
+			static_cast<std::size_t>(offsets[index + 1] - offsets[index]));
+	}
+
+	// Custom attributes: "data-" followed by lowercase letters, digits, '-', '_' or '.'
+	constexpr bool isDataAttributeName(std::string_view name) {
+		constexpr std::string_view prefix = "data-";
+		if (name.size() <= prefix.size() || name.substr(0, prefix.size()) != prefix) {
+			return false;
+		}
+		for (const char c : name.substr(prefix.size())) {
+			if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.')) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	namespace detail {
+		constexpr bool urlNeedsEncoding(char c) {
+			const auto byte = static_cast<unsigned char>(c);
+			return byte <= 0x20 || byte >= 0x7f || c == '"' || c == '<' || c == '>'
+				|| c == '\\' || c == '^' || c == '`' || c == '{' || c == '|' || c == '}';
+		}
+
+		// Escapes a text value in place so it cannot end its quotes or start a
+		// character reference: " becomes &quot; and & becomes &amp;
+		constexpr void escapeAttributeValue(std::string& value) {
+			std::size_t extra = 0;
+			for (const char c : value) {
+				extra += c == '"' ? 5 : c == '&' ? 4 : 0;
+			}
+			if (extra == 0) {
+				return;
+			}
+			std::size_t source = value.size();
+			value.resize(value.size() + extra);
+			std::size_t target = value.size();
+			const auto put = [&](std::string_view text) {
+				target -= text.size();
+				for (std::size_t i = 0; i < text.size(); ++i) {
+					value[target + i] = text[i];
+				}
+			};
+			while (source != 0) {
+				const char c = value[--source];
+				if (c == '"') {
+					put("&quot;");
+				}
+				else if (c == '&') {
+					put("&amp;");
+				}
+				else {
+					value[--target] = c;
+				}
+			}
+		}
+
+		// Whether an Attribute<Name, Value> value suits its type. Text is
+		// escaped at compile time; numbers and URLs must already be in their
+		// rendered form.
+		constexpr bool isStaticAttributeValue(AttributeType type, std::string_view value) {
+			for (const char c : value) {
+				const bool valid = type == AttributeType::Number
+					? (c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E'
+					: type != AttributeType::Url || !urlNeedsEncoding(c);
+				if (!valid) {
+					return false;
+				}
+			}
+			return type != AttributeType::Number || !value.empty();
+		}
+
+		// A static text value escaped as escapeAttributeValue does at runtime
+		template <fixed_string Value>
+		constexpr auto escapedAttributeValue() {
+			constexpr std::size_t size = [] {
+				std::string value(Value.view());
+				escapeAttributeValue(value);
+				return value.size();
+			}();
+			std::string value(Value.view());
+			escapeAttributeValue(value);
+			fixed_string<size + 1> result;
+			for (std::size_t i = 0; i < size; ++i) {
+				result.value[i] = value[i];
+			}
+			return result;
+		}
+	}
+
+	// A URL for attributes such as href and src. Spaces, quotes and other bytes
+	// that can't appear in a URL are percent-encoded once, here, not per render.
+	class Url {
+		std::string encoded;
+
+	public:
+		explicit Url(std::string_view url);
+
+		const std::string& view() const {
+			return encoded;
+		}
+	};
+
+	template <fixed_string Name, fixed_string... Value>
+	class Attribute;
+
+	// A standard or data-* attribute with a runtime value, e.g.
+	// Attribute<"href">{ Url{ link } } or Attribute<"disabled">{ true }. Values
+	// must match the attribute's type: text, a number, a bool or a Url.
+	// Numbers are formatted and text is escaped when the attribute is built. A
+	// number that cannot be formatted leaves the attribute out and fails the
+	// stream, as WriteNumber does.
+	template <fixed_string Name>
+	class Attribute<Name> {
+		static constexpr std::optional<std::size_t> index = findStandardAttribute(Name.view());
+		static_assert(Name.view() != "class" && Name.view() != "id", "Use Class and Id for class and id attributes");
+		static_assert(index.has_value() || isDataAttributeName(Name.view()),
+			"Not a standard attribute; use Data<\"...\"> for custom ones");
+
+	public:
+		using key = Attribute<Name>;
+		static constexpr AttributeType type = index ? standardAttributes[*index].type : AttributeType::Text;
+		static constexpr auto prefix = [] {
+			if constexpr (type == AttributeType::Boolean) {
+				return fixed_string{ " " } + Name;
+			}
+			else {
+				return fixed_string{ " " } + Name + fixed_string{ "=\"" };
+			}
+		}();
+
+	private:
+		std::conditional_t<type == AttributeType::Boolean, bool, std::string> value;
+		bool failed = false; // A number could not be formatted
+
+	public:
+		template <typename T>
+			requires (type == AttributeType::Text && !NumericValue<T> && std::is_constructible_v<std::string, T&&>)
+		constexpr explicit Attribute(T&& text) :
+			value(std::forward<T>(text))
+		{
+			detail::escapeAttributeValue(value);
+		}
+
+		template <NumericValue T>
+			requires (type == AttributeType::Text || type == AttributeType::Number)
+		explicit Attribute(T number, const NumberFormat& numberFormat = {}) {
+			char buffer[formattedNumberSize];
+			const char* const end = FormatNumber(buffer, buffer + sizeof(buffer), number, numberFormat);
+			if (end == nullptr) {
+				failed = true;
+				return;
+			}
+			value.assign(buffer, static_cast<std::size_t>(end - buffer));
+		}
+
+		// Only a bool, not anything convertible to one
+		template <std::same_as<bool> T>
+			requires (type == AttributeType::Boolean)
+		constexpr explicit Attribute(T present) :
+			value(present)
+		{}
+
+		explicit Attribute(const Url& url) requires (type == AttributeType::Url) :
+			value(url.view())
+		{}
+
+		void writeAttribute(std::ostream& stream) const {
+			if constexpr (type == AttributeType::Boolean) {
+				if (value) {
+					stream.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+				}
+			}
+			else {
+				if (failed) {
+					stream.setstate(std::ios_base::failbit);
+					return;
+				}
+				stream.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+				stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+				stream.put('"');
+			}
+		}
+
+		constexpr void writeStaticAttribute(StaticWriter& writer) const {
+			if constexpr (type == AttributeType::Boolean) {
+				if (value) {
+					writer.write(prefix.view());
+				}
+			}
+			else {
+				writer.write(prefix.view());
+				writer.write(value);
+				writer.put('"');
+			}
+		}
+	};
+
+	// An attribute whose value is known at compile time, e.g.
+	// Attribute<"type", "checkbox">, folded into the opening tag like Class<"...">
+	template <fixed_string Name, fixed_string Value>
+	class Attribute<Name, Value> {
+	public:
+		using key = Attribute<Name>;
+		static constexpr AttributeType type = Attribute<Name>::type;
+		static_assert(type != AttributeType::Boolean, "Boolean attributes take a bool, e.g. Attribute<\"hidden\">{ true }");
+		static_assert(detail::isStaticAttributeValue(type, Value.view()), "The value does not suit the attribute's type");
+
+		static constexpr auto text = [] {
+			if constexpr (type == AttributeType::Text) {
+				return Attribute<Name>::prefix + detail::escapedAttributeValue<Value>() + fixed_string{ "\"" };
+			}
+			else {
+				return Attribute<Name>::prefix + Value + fixed_string{ "\"" };
+			}
+		}();
+	};
+
+	// A custom data-* attribute, e.g. Data<"user-id">{ 42 } or Data<"role", "menu">
+	template <fixed_string Name, fixed_string... Value>
+	using Data = Attribute<fixed_string{ "data-" } + Name, Value...>;
+
+	// Attributes assembled at runtime, e.g. from configuration. Standard names
+	// are checked for duplicates with one bit each; data-* names by comparing
+	// against the other data-* names in the set.
+	class AttributeSet {
+		static constexpr std::uint16_t customName = 0xffff;
+
+		struct Entry {
+			std::uint16_t index; // In standardAttributes, or customName
+			std::string name; // Only for custom names
+			std::string value;
+		};
+
+	public:
+		enum class AddResult {
+			Inserted,
+			Duplicate, // The set already holds the name
+			Invalid // Not a standard or data-* name, a value of the wrong type or a number that cannot be formatted
+		};
+
+	private:
+		std::array<std::uint64_t, (standardAttributeCount + 63) / 64> present{};
+		std::vector<Entry> entries;
+
+		AddResult insert(std::string_view name, AttributeType type, std::string value, bool written = true);
+
+	public:
+		// Each add leaves the set unchanged unless it returns Inserted. Text is
+		// escaped as for Attribute.
+		AddResult add(std::string_view name, std::string_view text);
+		AddResult add(std::string_view name, const char* text) {
+			return add(name, std::string_view(text));
+		}
+		AddResult add(std::string_view name, bool present);
+		AddResult add(std::string_view name, const Url& url);
+
+		template <NumericValue T>
+		AddResult add(std::string_view name, T number, const NumberFormat& format = {}) {
+			char buffer[formattedNumberSize];
+			const char* const end = FormatNumber(buffer, buffer + sizeof(buffer), number, format);
+			if (end == nullptr) {
+				return AddResult::Invalid;
+			}
+			return insert(name, AttributeType::Number, std::string(buffer, static_cast<std::size_t>(end - buffer)));
+		}
+
+		bool contains(std::string_view name) const;
+
+		std::size_t size() const {
+			return entries.size();
+		}
+
+		void writeAttribute(std::ostream& stream) const;
+	};
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "render.hpp"
+#include "template.hpp"
+
+
+namespace Web {
+
+	struct BatchOptions {
+		// Worker threads to render with, 0 for one per hardware thread
+		std::size_t threads = 1;
+		// Bytes reserved per document before rendering starts
+		std::size_t reservePerDocument = 0;
+	};
+
+	// Every document of a batch back to back in one string
+	class BatchOutput {
+		std::string bytes;
+		std::vector<std::size_t> offsets;
+
+	public:
+		BatchOutput(std::string bytes, std::vector<std::size_t> offsets) :
+			bytes(std::move(bytes)),
+			offsets(std::move(offsets))
+		{
+			assert(!this->offsets.empty() && this->offsets.back() == this->bytes.size());
+		}
+
+		std::size_t size() const {
+			return offsets.size() - 1;
+		}
+		std::string_view document(std::size_t index) const {
+			return std::string_view(bytes).substr(offsets[index], offsets[index + 1] - offsets[index]);
+		}
+		const std::string& getBytes() const {
+			return bytes;
+		}
+		// The start of each document, followed by the end of the last
+		const std::vector<std::size_t>& getOffsets() const {
+			return offsets;
+		}
+	};
+
+	namespace detail {
+		template <typename... Args, typename Record, typename Extract>
+		void renderBatchChunk(const Template<Args...>& skeleton, std::span<const Record> records, Extract& extract,
+			std::size_t reservePerDocument, std::string& bytes, std::vector<std::size_t>& offsets)
+		{
+			bytes.reserve(records.size() * reservePerDocument);
+			offsets.reserve(offsets.size() + records.size() + 1);
+			StringBuffer buffer(bytes);
+			std::ostream stream(&buffer);
+			for (const Record& record : records) {
+				offsets.push_back(buffer.size());
+				std::apply([&](const auto&... fields) { skeleton.render(stream, fields...); }, extract(record));
+			}
+		}
+
+		template <typename... Args, typename Record, typename Extract>
+		BatchOutput renderBatch(const Template<Args...>& skeleton, std::span<const Record> records, Extract extract, BatchOptions options) {
+			std::size_t threads = options.threads == 0 ? std::thread::hardware_concurrency() : options.threads;
+			threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(records.size(), 1));
+
+			std::string bytes;
+			std::vector<std::size_t> offsets;
+			if (threads == 1) {
+				detail::renderBatchChunk(skeleton, records, extract, options.reservePerDocument, bytes, offsets);
+				offsets.push_back(bytes.size());
+				return BatchOutput(std::move(bytes), std::move(offsets));
+			}
+
+			// Each thread renders a contiguous run of records into its own arena,
+			// which are then joined in order
+			struct Chunk {
+				std::string bytes;
+				std::vector<std::size_t> offsets;
+				std::exception_ptr error;
+			};
+			std::vector<Chunk> chunks(threads);
+			const std::size_t perChunk = (records.size() + threads - 1) / threads;
+			const auto renderChunk = [&](std::size_t index) {
+				const std::size_t first = std::min(index * perChunk, records.size());
+				const std::size_t count = std::min(perChunk, records.size() - first);
+				try {
+					Extract chunkExtract = extract;
+					detail::renderBatchChunk(skeleton, records.subspan(first, count), chunkExtract,
+						options.reservePerDocument, chunks[index].bytes, chunks[index].offsets);
+				}
+				catch (...) {
+					chunks[index].error = std::current_exception();
+				}
+			};
+
+			std::vector<std::thread> workers;
+			workers.reserve(threads - 1);
+			for (std::size_t i = 1; i < threads; ++i) {
+				workers.emplace_back(renderChunk, i);
+			}
+			renderChunk(0);
+			for (auto& worker : workers) {
+				worker.join();
+			}
+
+			std::size_t total = 0;
+			for (const auto& chunk : chunks) {
+				if (chunk.error) {
+					std::rethrow_exception(chunk.error);
+				}
+				total += chunk.bytes.size();
+			}
+			bytes.reserve(total);
+			offsets.reserve(records.size() + 1);
+			for (const auto& chunk : chunks) {
+				const std::size_t base = bytes.size();
+				for (const std::size_t offset : chunk.offsets) {
+					offsets.push_back(base + offset);
+				}
+				bytes += chunk.bytes;
+			}
+			offsets.push_back(bytes.size());
+			return BatchOutput(std::move(bytes), std::move(offsets));
+		}
+	}
+
+	// Renders a document per record from a precompiled skeleton. records is any
+	// contiguous range, e.g. a std::vector or std::span; extract(record) returns
+	// the template arguments for that record as a tuple.
+	template <typename... Args, std::ranges::contiguous_range Records, typename Extract>
+		requires std::ranges::sized_range<Records>
+	BatchOutput renderBatch(const Template<Args...>& skeleton, Records&& records, Extract extract, BatchOptions options = {}) {
+		using Record = std::ranges::range_value_t<Records>;
+		return detail::renderBatch(skeleton, std::span<const Record>(std::ranges::data(records), std::ranges::size(records)),
+			std::move(extract), options);
+	}
+
+	// Renders a document per record, e.g.
+	//
+	//   const auto output = Web::renderBatch(users,
+	//       [](const auto& name, const auto& count) { return Web::P{ "Hello ", name, ", you have ", count, " messages" }; },
+	//       [](const User& user) { return std::tuple(user.name, user.unread); });
+	//
+	// build is called once with a Slot for each field extract returns, so it must
+	// only place its arguments into the tree; the skeleton it returns is
+	// compiled into a Template and every record then only fills the slots.
+	template <std::ranges::contiguous_range Records, typename Build, typename Extract>
+		requires std::ranges::sized_range<Records>
+	BatchOutput renderBatch(Records&& records, Build build, Extract extract, BatchOptions options = {}) {
+		using Record = std::ranges::range_value_t<Records>;
+		// Fields may be references, e.g. from std::tie
+		using Fields = std::decay_t<std::invoke_result_t<Extract&, const Record&>>;
+		return [&]<std::size_t... I>(std::index_sequence<I...>) {
+			const Template<std::decay_t<std::tuple_element_t<I, Fields>>...> skeleton{
+				build(Slot<I, std::decay_t<std::tuple_element_t<I, Fields>>>{}...)
+			};
+			return renderBatch(skeleton, records, std::move(extract), options);
+		}(std::make_index_sequence<std::tuple_size_v<Fields>>{});
+	}
+}
@@ -0,0 +1,246 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace Web {
+
+	struct BufferPoolOptions {
+		// Buffers grow a chunk of this size at a time, never copying what is written
+		std::size_t chunkSize = 16 * 1024;
+		// Free chunks beyond this many bytes go back to the allocator
+		std::size_t maxPooledBytes = 4 * 1024 * 1024;
+		// Weight of the newest render in each document type's size estimate
+		double smoothing = 0.25;
+	};
+
+	class BufferPool;
+
+	// A streambuf that collects a render in chunks taken from a BufferPool and
+	// returns them when destroyed. It must be destroyed on the thread that
+	// acquired it, e.g. once the response has been sent.
+	class RenderBuffer : public std::streambuf {
+		using Chunk = std::unique_ptr<char[]>;
+
+		BufferPool& pool;
+		const void* kind;
+		std::vector<Chunk> chunks;
+		std::size_t used = 0; // Chunks filled before the current one
+
+		friend class BufferPool;
+
+		RenderBuffer(BufferPool& pool, const void* kind, std::vector<Chunk> chunks);
+
+		std::size_t chunkSize() const;
+		void nextChunk();
+
+	public:
+		RenderBuffer(const RenderBuffer&) = delete;
+		RenderBuffer& operator=(const RenderBuffer&) = delete;
+		~RenderBuffer() override;
+
+		// Bytes written so far
+		std::size_t size() const {
+			return used * chunkSize() + static_cast<std::size_t>(pptr() - pbase());
+		}
+
+		// Calls f(std::string_view) for each filled part of a chunk in order,
+		// e.g. to build an iovec array for writev
+		template <typename F>
+		void forEachChunk(F&& f) const {
+			for (std::size_t i = 0; i < used; ++i) {
+				f(std::string_view(chunks[i].get(), chunkSize()));
+			}
+			if (pptr() != pbase()) {
+				f(std::string_view(pbase(), static_cast<std::size_t>(pptr() - pbase())));
+			}
+		}
+
+		std::string str() const {
+			std::string result;
+			result.reserve(size());
+			forEachChunk([&result](std::string_view chunk) { result += chunk; });
+			return result;
+		}
+
+	protected:
+		int_type overflow(int_type c) override {
+			nextChunk();
+			if (!traits_type::eq_int_type(c, traits_type::eof())) {
+				*pptr() = traits_type::to_char_type(c);
+				pbump(1);
+			}
+			return traits_type::not_eof(c);
+		}
+
+		std::streamsize xsputn(const char* s, std::streamsize count) override {
+			if (count <= epptr() - pptr()) {
+				std::memcpy(pptr(), s, static_cast<std::size_t>(count));
+				pbump(static_cast<int>(count));
+				return count;
+			}
+			auto remaining = static_cast<std::size_t>(count);
+			while (remaining > 0) {
+				if (pptr() == epptr()) {
+					nextChunk();
+				}
+				const std::size_t part = std::min(remaining, static_cast<std::size_t>(epptr() - pptr()));
+				std::memcpy(pptr(), s, part);
+				pbump(static_cast<int>(part)); // part is at most one chunk
+				s += part;
+				remaining -= part;
+			}
+			return count;
+		}
+	};
+
+	// Recycles render buffer chunks on one thread and learns how big each kind
+	// of document renders, so a buffer starts with enough chunks for it, e.g.
+	//
+	//   auto buffer = Web::BufferPool::local().acquire<ProductPage>();
+	//   std::ostream stream(&buffer);
+	//   stream << page;
+	//   buffer.forEachChunk([&](std::string_view chunk) { send(chunk); });
+	class BufferPool {
+		using Chunk = std::unique_ptr<char[]>;
+
+		BufferPoolOptions options;
+		std::vector<Chunk> freeChunks;
+		std::vector<std::vector<Chunk>> freeLists; // Emptied chunk vectors, kept for their capacity
+		std::unordered_map<const void*, std::size_t> estimates;
+
+		template <typename T>
+		static const void* kindOf() {
+			static const char key = 0;
+			return &key;
+		}
+
+		Chunk takeChunk() {
+			if (freeChunks.empty()) {
+				return Chunk(new char[options.chunkSize]);
+			}
+			Chunk chunk = std::move(freeChunks.back());
+			freeChunks.pop_back();
+			return chunk;
+		}
+
+		RenderBuffer acquire(const void* kind) {
+			std::vector<Chunk> chunks;
+			if (!freeLists.empty()) {
+				chunks = std::move(freeLists.back());
+				freeLists.pop_back();
+			}
+			// A quarter over the estimate, so an average render never grows
+			const std::size_t estimate = getEstimate(kind);
+			const std::size_t wanted = std::max<std::size_t>(1, (estimate + estimate / 4 + options.chunkSize - 1) / options.chunkSize);
+			while (chunks.size() < wanted) {
+				chunks.push_back(takeChunk());
+			}
+			return RenderBuffer(*this, kind, std::move(chunks));
+		}
+
+		void release(const void* kind, std::size_t rendered, std::vector<Chunk>& chunks) {
+			std::size_t& estimate = estimates[kind];
+			estimate = estimate == 0
+				? rendered
+				: static_cast<std::size_t>(static_cast<double>(estimate) + options.smoothing * (static_cast<double>(rendered) - static_cast<double>(estimate)));
+
+			for (Chunk& chunk : chunks) {
+				if ((freeChunks.size() + 1) * options.chunkSize > options.maxPooledBytes) {
+					break; // The rest are freed with the vector
+				}
+				freeChunks.push_back(std::move(chunk));
+			}
+			chunks.clear();
+			if (freeLists.size() < maxFreeLists) {
+				freeLists.push_back(std::move(chunks));
+			}
+		}
+
+		friend class RenderBuffer;
+
+	public:
+		// Chunk vectors kept for reuse, enough for this many buffers in use at once
+		static constexpr std::size_t maxFreeLists = 16;
+
+		explicit BufferPool(BufferPoolOptions options = {}) :
+			options(options)
+		{
+			assert(options.chunkSize > 0);
+		}
+		BufferPool(const BufferPool&) = delete;
+		BufferPool& operator=(const BufferPool&) = delete;
+
+		// The pool for the current thread
+		static BufferPool& local() {
+			thread_local BufferPool pool;
+			return pool;
+		}
+
+		// A buffer for rendering a Document, sized from the Documents rendered before
+		template <typename Document>
+		RenderBuffer acquire() {
+			return acquire(kindOf<Document>());
+		}
+
+		template <typename Document>
+		std::size_t getEstimate() const {
+			return getEstimate(kindOf<Document>());
+		}
+		std::size_t getEstimate(const void* kind) const {
+			const auto it = estimates.find(kind);
+			return it == estimates.end() ? 0 : it->second;
+		}
+
+		// Bytes held in free chunks
+		std::size_t getPooledBytes() const {
+			return freeChunks.size() * options.chunkSize;
+		}
+
+		std::size_t getChunkSize() const {
+			return options.chunkSize;
+		}
+	};
+
+	inline RenderBuffer::RenderBuffer(BufferPool& pool, const void* kind, std::vector<Chunk> chunks) :
+		pool(pool),
+		kind(kind),
+		chunks(std::move(chunks))
+	{
+		setp(this->chunks[0].get(), this->chunks[0].get() + chunkSize());
+	}
+
+	inline RenderBuffer::~RenderBuffer() {
+		pool.release(kind, size(), chunks);
+	}
+
+	inline std::size_t RenderBuffer::chunkSize() const {
+		return pool.getChunkSize();
+	}
+
+	inline void RenderBuffer::nextChunk() {
+		++used;
+		if (used == chunks.size()) {
+			chunks.push_back(pool.takeChunk());
+		}
+		setp(chunks[used].get(), chunks[used].get() + chunkSize());
+	}
+
+	// Appends the HTML for node to a pooled buffer and returns it
+	template <typename T>
+	RenderBuffer& render(RenderBuffer& out, const T& node) {
+		std::ostream stream(&out);
+		stream << node;
+		return out;
+	}
+}
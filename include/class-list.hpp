@@ -0,0 +1,219 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "web.hpp"
+
+
+namespace Web {
+
+	namespace detail {
+		constexpr bool isClassSpace(char c) {
+			return c == ' ' || c == '\t' || c == '\n' || c == '\f' || c == '\r';
+		}
+
+		// One class: not empty, no whitespace and nothing that ends the attribute
+		constexpr bool isClassName(std::string_view name) {
+			if (name.empty()) {
+				return false;
+			}
+			for (const char c : name) {
+				if (isClassSpace(c) || c == '"') {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr std::uint32_t hashClassName(std::string_view name) {
+			std::uint32_t hash = 2166136261u;
+			for (const char c : name) {
+				hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+			}
+			return hash;
+		}
+
+		// The classes a ClassList gains at runtime, in the order they were
+		// added, each kept once and never repeating one of the list's static
+		// classes. A flat set: up to inlineCapacity classes are held in place
+		// and found by comparing hashes.
+		class ClassListSet {
+			struct Entry {
+				const char* name; // A name with static storage, or nullptr for one in text
+				std::uint32_t offset; // Into text
+				std::uint32_t length;
+				std::uint32_t hash;
+			};
+
+			static constexpr std::size_t inlineCapacity = 8;
+
+			const std::string_view* staticNames;
+			const std::uint32_t* staticHashes;
+			std::size_t staticCount;
+
+			std::size_t count = 0;
+			Entry inlineEntries[inlineCapacity]{};
+			std::vector<Entry> moreEntries;
+			// Classes added as runtime strings, back to back
+			std::string text;
+
+			const Entry& entry(std::size_t index) const {
+				return index < inlineCapacity ? inlineEntries[index] : moreEntries[index - inlineCapacity];
+			}
+			std::string_view nameOf(const Entry& entry) const {
+				return std::string_view(entry.name != nullptr ? entry.name : text.data() + entry.offset, entry.length);
+			}
+			bool containsAdded(std::string_view name, std::uint32_t hash) const;
+			void push(const Entry& entry);
+
+		public:
+			ClassListSet(const std::string_view* staticNames, const std::uint32_t* staticHashes, std::size_t staticCount) :
+				staticNames(staticNames),
+				staticHashes(staticHashes),
+				staticCount(staticCount)
+			{}
+
+			// Adds each whitespace separated class in classes, copying it
+			void add(std::string_view classes);
+			// Adds one class whose name outlives the set, without copying it. The
+			// caller has already checked it against the static classes.
+			void addStatic(std::string_view name, std::uint32_t hash);
+
+			bool contains(std::string_view name) const;
+
+			std::size_t size() const {
+				return count;
+			}
+
+			// Writes prefix, the classes separated by spaces and the closing quote.
+			// The classes start with a space when they follow static ones.
+			void write(std::ostream& stream, std::string_view prefix, bool leadingSpace) const;
+		};
+	}
+
+	// A class included in a ClassList only when a condition holds, e.g.
+	// Web::ClassIf<"ring-2">{ selected }. The name is not copied.
+	template <fixed_string Name>
+	struct ClassIf {
+		static_assert(detail::isClassName(Name.view()), "ClassIf takes a single class name");
+
+		bool enabled;
+	};
+
+	// A class attribute made of many classes, e.g. for utility CSS:
+	//
+	//   Web::ClassList<"flex", "items-center", "gap-2">{ Web::ClassIf<"ring-2">{ selected }, theme.accent }
+	//
+	// The classes in the template arguments are joined into the attribute's
+	// prefix at compile time. Others are added by the constructor or add() as
+	// ClassIf, or as strings of whitespace separated classes, which are copied.
+	// Each class is written once, however often it is added, and the list is
+	// written straight to the stream. A ClassList stands in for Class, so Attr
+	// rejects having both.
+	template <fixed_string... Static>
+	class ClassList {
+		static_assert((detail::isClassName(Static.view()) && ...), "Static classes must be single class names");
+
+		static constexpr std::size_t staticCount = sizeof...(Static);
+		static constexpr std::array<std::string_view, staticCount> staticNames{ Static.view()... };
+		static constexpr std::array<std::uint32_t, staticCount> staticHashes{ detail::hashClassName(Static.view())... };
+
+		static constexpr bool uniqueStaticNames() {
+			for (std::size_t i = 0; i < staticCount; ++i) {
+				for (std::size_t j = i + 1; j < staticCount; ++j) {
+					if (staticNames[i] == staticNames[j]) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+		static_assert(uniqueStaticNames(), "Static classes must not contain duplicates");
+
+		detail::ClassListSet classes;
+
+	public:
+		using key = Class<>;
+
+		// " class=\"" and the static classes, written with a single write
+		static constexpr auto prefix = [] {
+			constexpr std::string_view start = " class=\"";
+			fixed_string<start.size() + (0 + ... + Static.size()) + (staticCount == 0 ? 0 : staticCount - 1) + 1> result;
+			std::size_t size = 0;
+			const auto append = [&](std::string_view text) {
+				for (const char c : text) {
+					result.value[size++] = c;
+				}
+			};
+			append(start);
+			for (std::size_t i = 0; i < staticCount; ++i) {
+				if (i != 0) {
+					append(" ");
+				}
+				append(staticNames[i]);
+			}
+			return result;
+		}();
+
+		template <typename... Args>
+			requires (!std::is_same_v<std::decay_t<Args>, ClassList> && ...)
+		explicit ClassList(Args&&... args) :
+			classes(staticNames.data(), staticHashes.data(), staticCount)
+		{
+			(add(std::forward<Args>(args)), ...);
+		}
+
+		ClassList& add(std::string_view classNames) {
+			classes.add(classNames);
+			return *this;
+		}
+		template <fixed_string Name>
+		ClassList& add(ClassIf<Name> conditional) {
+			// Static classes are matched when compiling, leaving only the added
+			// ones to compare against
+			constexpr bool isStatic = ((Name.view() == Static.view()) || ...);
+			if constexpr (!isStatic) {
+				if (conditional.enabled) {
+					constexpr std::uint32_t hash = detail::hashClassName(Name.view());
+					classes.addStatic(Name.view(), hash);
+				}
+			}
+			return *this;
+		}
+		ClassList& addIf(bool condition, std::string_view classNames) {
+			if (condition) {
+				classes.add(classNames);
+			}
+			return *this;
+		}
+
+		bool contains(std::string_view name) const {
+			for (const std::string_view staticName : staticNames) {
+				if (staticName == name) {
+					return true;
+				}
+			}
+			return classes.contains(name);
+		}
+
+		std::size_t size() const {
+			return staticCount + classes.size();
+		}
+
+		// Writes nothing when there are no classes at all
+		void writeAttribute(std::ostream& stream) const {
+			if constexpr (staticCount == 0) {
+				if (classes.size() == 0) {
+					return;
+				}
+			}
+			classes.write(stream, prefix.view(), staticCount != 0);
+		}
+	};
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <concepts>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include "web.hpp"
+
+
+namespace Web {
+
+	// A subtree whose type is hidden behind a virtual render call, so that the
+	// element types of a large page stay small. Build the subtree in its own
+	// translation unit and return it as a Component:
+	//
+	//   // sidebar.hpp
+	//   Web::Component makeSidebar(const User& user);
+	//
+	//   // sidebar.cpp
+	//   Web::Component makeSidebar(const User& user) {
+	//       return Web::Component{ Web::Aside{ Web::H2{ user.name }, ... } };
+	//   }
+	//
+	//   // page.cpp only sees Body<Component, ...>
+	//   stream << Web::Html{ Web::Body{ makeSidebar(user), content } };
+	//
+	// The subtree's render code is instantiated once, in sidebar.cpp. Copies
+	// share the subtree, which must not change after it is wrapped. Components
+	// count as any content, as their categories are not known at compile time.
+	class Component {
+	public:
+		// Implement this to render without building a subtree at all
+		class Renderer {
+		public:
+			virtual ~Renderer() = default;
+			virtual void render(std::ostream& stream) const = 0;
+		};
+
+	private:
+		template <typename T>
+		class Subtree final : public Renderer {
+			const T node;
+
+		public:
+			explicit Subtree(T node) :
+				node(std::move(node))
+			{}
+
+			void render(std::ostream& stream) const override {
+				WriteToStream(stream, node);
+			}
+		};
+
+		std::shared_ptr<const Renderer> renderer;
+
+	public:
+		template <typename T>
+			requires (!std::is_same_v<std::decay_t<T>, Component>
+				&& !std::convertible_to<T, std::shared_ptr<const Renderer>>)
+		explicit Component(T&& node) :
+			renderer(std::make_shared<const Subtree<std::decay_t<T>>>(std::forward<T>(node)))
+		{}
+
+		explicit Component(std::shared_ptr<const Renderer> renderer) :
+			renderer(std::move(renderer))
+		{
+			assert(this->renderer != nullptr);
+		}
+
+		void render(std::ostream& stream) const {
+			renderer->render(stream);
+		}
+	};
+
+	inline void WriteToStream(std::ostream& stream, const Component& component) {
+		component.render(stream);
+	}
+
+	inline std::ostream& operator<<(std::ostream& stream, const Component& component) {
+		component.render(stream);
+		return stream;
+	}
+}
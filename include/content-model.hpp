@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "number.hpp"
+
+// Set to 0 to compile without checking element children against the content model
+#ifndef WEB_CONTENT_MODEL_VALIDATION
+#define WEB_CONTENT_MODEL_VALIDATION 1
+#endif
+
+
+namespace Web {
+
+	// The HTML content model as bitmasks. Every element has the categories it
+	// belongs to and the categories it permits as children, so checking a child
+	// is a single AND rather than a search through types.
+	using ContentCategories = std::uint32_t;
+
+	namespace Content {
+		inline constexpr ContentCategories None = 0;
+		inline constexpr ContentCategories Metadata = 1u << 0;
+		inline constexpr ContentCategories Flow = 1u << 1;
+		inline constexpr ContentCategories Sectioning = 1u << 2;
+		inline constexpr ContentCategories Heading = 1u << 3;
+		inline constexpr ContentCategories Phrasing = 1u << 4;
+		inline constexpr ContentCategories Embedded = 1u << 5;
+		inline constexpr ContentCategories Interactive = 1u << 6;
+		inline constexpr ContentCategories Text = 1u << 7;
+
+		// Elements that only fit in specific parents
+		inline constexpr ContentCategories Head = 1u << 8;
+		inline constexpr ContentCategories Body = 1u << 9;
+		inline constexpr ContentCategories ListItem = 1u << 10;
+		inline constexpr ContentCategories Caption = 1u << 11;
+		inline constexpr ContentCategories TableSection = 1u << 12;
+		inline constexpr ContentCategories TableRow = 1u << 13;
+		inline constexpr ContentCategories TableCell = 1u << 14;
+
+		// Children whose markup is unknown at compile time, e.g. raw fragments
+		inline constexpr ContentCategories Any = ~ContentCategories{ 0 };
+
+		// Text is valid wherever phrasing content is
+		inline constexpr ContentCategories TextRun = Flow | Phrasing | Text;
+	}
+
+	// The categories of a child type. Elements declare theirs; text and numbers
+	// are TextRun; anything else is Any and is not checked.
+	template <typename T>
+	struct content_categories {
+		static constexpr ContentCategories value = Content::Any;
+	};
+	template <typename T>
+		requires requires { { T::categories } -> std::convertible_to<ContentCategories>; }
+	struct content_categories<T> {
+		static constexpr ContentCategories value = T::categories;
+	};
+	template <typename T>
+	struct content_categories<std::vector<T>> : content_categories<T> {};
+	template <>
+	struct content_categories<std::string> {
+		static constexpr ContentCategories value = Content::TextRun;
+	};
+	template <>
+	struct content_categories<std::string_view> {
+		static constexpr ContentCategories value = Content::TextRun;
+	};
+	template <>
+	struct content_categories<const char*> {
+		static constexpr ContentCategories value = Content::TextRun;
+	};
+	template <>
+	struct content_categories<char> {
+		static constexpr ContentCategories value = Content::TextRun;
+	};
+	template <std::size_t N>
+	struct content_categories<char[N]> {
+		static constexpr ContentCategories value = Content::TextRun;
+	};
+	template <NumericValue T>
+	struct content_categories<T> {
+		static constexpr ContentCategories value = Content::TextRun;
+	};
+	template <typename T>
+	struct content_categories<Number<T>> {
+		static constexpr ContentCategories value = Content::TextRun;
+	};
+
+	template <typename T>
+	inline constexpr ContentCategories content_categories_v = content_categories<std::remove_cvref_t<T>>::value;
+
+	// The categories an element permits as children. Types that do not say permit anything.
+	template <typename T>
+	inline constexpr ContentCategories permitted_content_v = Content::Any;
+	template <typename T>
+		requires requires { { T::permittedContent } -> std::convertible_to<ContentCategories>; }
+	inline constexpr ContentCategories permitted_content_v<T> = T::permittedContent;
+
+	// Categories an element never permits among its descendants, even when they
+	// match permittedContent, e.g. interactive content inside <a>. Children are
+	// checked when compiling; deeper descendants are stored type erased, so they
+	// are checked by runtime validation as the document renders.
+	template <typename T>
+	inline constexpr ContentCategories forbidden_content_v = Content::None;
+	template <typename T>
+		requires requires { { T::forbiddenContent } -> std::convertible_to<ContentCategories>; }
+	inline constexpr ContentCategories forbidden_content_v<T> = T::forbiddenContent;
+
+	template <typename Parent, typename Child>
+	constexpr bool permits_child() {
+		constexpr ContentCategories child = content_categories_v<Child>;
+		return child == Content::Any
+			|| ((child & permitted_content_v<Parent>) != 0 && (child & forbidden_content_v<Parent>) == 0);
+	}
+
+	// Instantiated per parent and child so the failing pair appears in the error
+	template <typename Parent, typename Child>
+	struct check_child {
+		static_assert(permits_child<Parent, Child>(), "The content model does not allow this child in this element");
+		static constexpr bool value = true;
+	};
+
+	template <typename T>
+	concept VoidElement = T::isVoid;
+}
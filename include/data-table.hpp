@@ -0,0 +1,203 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include "web.hpp"
+
+
+namespace Web {
+
+	// Buffers the cells of a DataTable and writes them to the stream in large
+	// blocks. Column formatters write their cell text through it.
+	class CellWriter {
+		static constexpr std::size_t capacity = 16 * 1024;
+
+		std::streambuf& sink;
+		char buffer[capacity];
+		std::size_t used = 0;
+		bool failed = false;
+
+	public:
+		explicit CellWriter(std::streambuf& sink) :
+			sink(sink)
+		{}
+		CellWriter(const CellWriter&) = delete;
+		CellWriter& operator=(const CellWriter&) = delete;
+		~CellWriter() {
+			flush();
+		}
+
+		void write(std::string_view text) {
+			if (capacity - used < text.size()) {
+				flush();
+				if (text.size() > capacity) {
+					failed |= sink.sputn(text.data(), static_cast<std::streamsize>(text.size())) != static_cast<std::streamsize>(text.size());
+					return;
+				}
+			}
+			std::memcpy(buffer + used, text.data(), text.size());
+			used += text.size();
+		}
+
+		// A number that cannot be formatted, e.g. an integer with an extreme
+		// precision, is left out and the writer fails
+		template <NumericValue T>
+		void writeNumber(T value, const NumberFormat& format = {}) {
+			char* end = FormatNumber(buffer + used, buffer + capacity, value, format);
+			if (!end) {
+				flush();
+				end = FormatNumber(buffer, buffer + capacity, value, format);
+				if (!end) {
+					failed = true;
+					return;
+				}
+			}
+			used = static_cast<std::size_t>(end - buffer);
+		}
+
+		void flush() {
+			failed |= sink.sputn(buffer, static_cast<std::streamsize>(used)) != static_cast<std::streamsize>(used);
+			used = 0;
+		}
+
+		bool hasFailed() const {
+			return failed;
+		}
+	};
+
+	// Writes numbers with a NumberFormat and anything convertible to a string_view as is
+	struct DefaultCellFormat {
+		NumberFormat format;
+
+		template <typename T>
+		void operator()(CellWriter& out, const T& value) const {
+			if constexpr (NumericValue<T>) {
+				out.writeNumber(value, format);
+			}
+			else {
+				out.write(std::string_view(value));
+			}
+		}
+	};
+
+	// A column of a DataTable: a heading, the values of every row and how to
+	// format them. Format is called as format(CellWriter&, const T&).
+	template <typename T, typename Format = DefaultCellFormat>
+	struct Column {
+		std::string_view heading;
+		std::span<const T> values;
+		Format format{};
+	};
+	template <typename T>
+	Column(std::string_view, std::span<const T>) -> Column<T>;
+	template <typename T>
+	Column(std::string_view, std::span<T>) -> Column<T>;
+	template <typename T>
+	Column(std::string_view, std::span<const T>, NumberFormat) -> Column<T>;
+	template <typename T>
+	Column(std::string_view, std::span<T>, NumberFormat) -> Column<T>;
+	template <typename T, typename Format>
+	Column(std::string_view, std::span<const T>, Format) -> Column<T, Format>;
+	template <typename T, typename Format>
+	Column(std::string_view, std::span<T>, Format) -> Column<T, Format>;
+
+	// A <table> rendered straight from column data, with no element per row or
+	// cell. Named DataTable because Web::Table is the plain element, e.g.
+	//
+	//   Web::DataTable table{
+	//       Web::Column{ "Name", std::span(names) },
+	//       Web::Column{ "Price", std::span(prices), Web::NumberFormat{ .precision = 2 } }
+	//   };
+	//
+	// Every column must have the same number of values.
+	template <typename... Columns>
+	class DataTable {
+		static_assert(sizeof...(Columns) > 0, "A DataTable needs at least one column");
+
+		std::tuple<Columns...> columns;
+		std::size_t rows;
+		std::string head; // <table><thead>...</thead><tbody>
+
+		static constexpr std::string_view rowStart = "<tr><td>";
+		static constexpr std::string_view cellSeparator = "</td><td>";
+		static constexpr std::string_view rowEnd = "</td></tr>";
+		static constexpr std::string_view tail = "</tbody></table>";
+
+		template <std::size_t I>
+		void writeCell(CellWriter& out, std::size_t row) const {
+			const auto& column = std::get<I>(columns);
+			column.format(out, column.values[row]);
+		}
+
+		template <std::size_t... I>
+		void writeRows(CellWriter& out, std::index_sequence<I...>) const {
+			for (std::size_t row = 0; row < rows; ++row) {
+				out.write(rowStart);
+				((I == 0 ? void() : out.write(cellSeparator), writeCell<I>(out, row)), ...);
+				out.write(rowEnd);
+			}
+		}
+
+	public:
+		static constexpr ContentCategories categories = Content::Flow;
+
+		// Throws std::invalid_argument when the columns have different
+		// lengths, as rendering would read past the end of the shorter ones
+		explicit DataTable(Columns... columns) :
+			columns(std::move(columns)...),
+			rows(std::get<0>(this->columns).values.size())
+		{
+			head = "<table><thead><tr>";
+			std::apply([this](const auto&... column) {
+				if (!((column.values.size() == rows) && ...)) {
+					throw std::invalid_argument("DataTable columns have different lengths");
+				}
+				((head += "<th>", head += column.heading, head += "</th>"), ...);
+			}, this->columns);
+			head += "</tr></thead><tbody>";
+		}
+
+		std::size_t getRowCount() const {
+			return rows;
+		}
+
+		std::ostream& streamOut(std::ostream& stream) const {
+#if WEB_VALIDATE
+			const ValidationScope validation("table", categories,
+				Content::Caption | Content::TableSection | Content::TableRow, Content::None);
+#endif
+#if WEB_PROFILE
+			const ProfileScope profile("table", stream);
+#endif
+			const std::ostream::sentry sentry(stream);
+			if (!sentry) {
+				return stream;
+			}
+			bool failed = false;
+			{
+				CellWriter out(*stream.rdbuf());
+				out.write(head);
+				writeRows(out, std::index_sequence_for<Columns...>{});
+				out.write(tail);
+				out.flush();
+				failed = out.hasFailed();
+			}
+			if (failed) {
+				stream.setstate(std::ios_base::badbit);
+			}
+			return stream;
+		}
+	};
+
+	template <typename... Columns>
+	std::ostream& operator<<(std::ostream& stream, const DataTable<Columns...>& table) {
+		return table.streamOut(stream);
+	}
+}
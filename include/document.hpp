@@ -0,0 +1,446 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "web.hpp"
+
+
+namespace Web {
+
+	// A document assembled at runtime, stored as flat tables rather than nested
+	// objects: a node table, a child index array, an attribute table and one
+	// text pool that holds tag names, attribute values and text.
+	class Document {
+	public:
+		using NodeIndex = std::uint32_t;
+
+		enum class NodeKind : std::uint8_t {
+			Element,
+			Void, // An element without children or a closing tag, e.g. <br>
+			Text,
+			Raw // Markup written verbatim, e.g. comments
+		};
+
+		// A range of bytes in the text pool
+		struct TextRange {
+			std::uint32_t offset = 0;
+			std::uint32_t length = 0;
+		};
+
+		struct Node {
+			NodeKind kind;
+			TextRange text; // The tag name of an element or the content of a text node
+			std::uint32_t firstAttribute;
+			std::uint32_t attributeCount;
+			std::uint32_t firstChild; // Index into the child index array
+			std::uint32_t childCount;
+		};
+
+		struct Attribute {
+			TextRange name;
+			TextRange value;
+		};
+
+		const std::vector<Node>& getNodes() const {
+			return nodes;
+		}
+		const std::vector<NodeIndex>& getChildIndices() const {
+			return childIndices;
+		}
+		const std::vector<Attribute>& getAttributes() const {
+			return attributes;
+		}
+		const std::string& getTextPool() const {
+			return textPool;
+		}
+
+		std::string_view getText(TextRange range) const {
+			return std::string_view(textPool).substr(range.offset, range.length);
+		}
+
+		// The top level nodes of the document, in order
+		std::pair<const NodeIndex*, const NodeIndex*> getRoots() const {
+			const NodeIndex* first = childIndices.data() + rootFirst;
+			return { first, first + rootCount };
+		}
+
+		std::ostream& streamOut(std::ostream& stream) const;
+
+		// Bytes held by the node, child index, attribute and text tables
+		std::size_t getMemoryUsage() const {
+			return nodes.size() * sizeof(Node)
+				+ childIndices.size() * sizeof(NodeIndex)
+				+ attributes.size() * sizeof(Attribute)
+				+ textPool.size()
+				+ cachedBytes.size() * sizeof(TextRange);
+		}
+
+	private:
+		struct Frame {
+			NodeIndex node;
+			std::uint32_t nextChild;
+		};
+
+		// Documents up to this deep render with a stack of frames in place;
+		// deeper ones allocate it
+		static constexpr std::size_t inlineStackDepth = 64;
+
+		// The stack needs room for maxDepth + 1 frames: one per element and
+		// one for a text node inside the deepest
+		template <typename Write>
+		void writeSubtree(NodeIndex root, Frame* stack, Write& write) const {
+			const char* const pool = textPool.data();
+			auto writeRange = [&write, pool](TextRange range) {
+				write(pool + range.offset, range.length);
+			};
+
+			std::size_t depth = 0;
+			stack[depth++] = Frame{ root, 0 };
+			bool entering = true;
+
+			while (depth != 0) {
+				Frame& frame = stack[depth - 1];
+				const Node& node = nodes[frame.node];
+
+				if (node.kind == NodeKind::Text || node.kind == NodeKind::Raw) {
+					writeRange(node.text);
+					--depth;
+					entering = false;
+					continue;
+				}
+
+				if (entering) {
+					if (!cachedBytes.empty() && cachedBytes[frame.node].length != 0) {
+						writeRange(cachedBytes[frame.node]);
+						--depth;
+						entering = false;
+						continue;
+					}
+					write("<", 1);
+					writeRange(node.text);
+					for (std::uint32_t a = 0; a < node.attributeCount; ++a) {
+						const Attribute& attribute = attributes[node.firstAttribute + a];
+						write(" ", 1);
+						writeRange(attribute.name);
+						write("=\"", 2);
+						writeRange(attribute.value);
+						write("\"", 1);
+					}
+					write(">", 1);
+					if (node.kind == NodeKind::Void) {
+						--depth;
+						entering = false;
+						continue;
+					}
+				}
+
+				if (frame.nextChild < node.childCount) {
+					const NodeIndex child = childIndices[node.firstChild + frame.nextChild++];
+					stack[depth++] = Frame{ child, 0 };
+					entering = true;
+				}
+				else {
+					write("</", 2);
+					writeRange(node.text);
+					write(">", 1);
+					--depth;
+					entering = false;
+				}
+			}
+		}
+
+		friend class DocumentBuilder;
+
+		std::vector<Node> nodes;
+		std::vector<NodeIndex> childIndices;
+		std::vector<Attribute> attributes;
+		std::string textPool;
+		// The rendered bytes of shared subtrees, by node, when the builder cached them
+		std::vector<TextRange> cachedBytes;
+
+		std::uint32_t rootFirst = 0;
+		std::uint32_t rootCount = 0;
+		std::uint32_t maxDepth = 0;
+	};
+
+	std::ostream& operator<<(std::ostream& stream, const Document& document);
+
+	// The first misuse of a DocumentBuilder. The builder carries on with a
+	// well formed document: the offending call is dropped, or for
+	// UnclosedElement the open elements are closed.
+	struct BuildError {
+		enum class Code {
+			None,
+			MisplacedAttribute, // attribute() after the element's content, or with no element
+			UnmatchedClose, // close() without a matching open()
+			UnclosedElement, // finish() with elements still open
+			InvalidNumber // text() with a number that could not be formatted
+		};
+
+		Code code = Code::None;
+
+		explicit operator bool() const {
+			return code != Code::None;
+		}
+	};
+
+	// Builds a Document in document order using the existing tag types, e.g.
+	//
+	//   Web::DocumentBuilder builder;
+	//   builder.open<Web::Div>().attribute(Web::Class{ "list" });
+	//   builder.element<Web::P>("text");
+	//   builder.close();
+	//   Web::Document doc = builder.finish();
+	//
+	// Children are collected on a shared scratch stack and copied into the
+	// child index array when their parent closes, so every node's children are
+	// contiguous and building needs only amortised vector growth.
+	struct DocumentBuilderOptions {
+		// Store structurally identical element subtrees once, pointing every
+		// parent at the first copy. Elements with the same tag, attributes and
+		// children in order are identical.
+		bool deduplicateSubtrees = false;
+		// Also keep the rendered bytes of each subtree used more than once, so
+		// rendering it is a single write. Needs deduplicateSubtrees.
+		bool cacheSharedSubtrees = false;
+	};
+
+	class DocumentBuilder {
+		struct OpenElement {
+			Document::NodeIndex node;
+			std::size_t firstPending;
+			// Table sizes when the element opened; its subtree is everything after
+			std::size_t childIndexMark;
+			std::size_t textMark;
+			std::size_t tagMark;
+		};
+
+		struct InternedTag {
+			const char* key;
+			Document::TextRange range;
+		};
+
+		struct Subtree {
+			std::uint64_t hash;
+			Document::NodeIndex node;
+		};
+
+		DocumentBuilderOptions options;
+		Document document;
+		std::vector<OpenElement> openElements;
+		std::vector<Document::NodeIndex> pending;
+		std::vector<InternedTag> tags;
+		// The element that attribute() applies to, until it gets content
+		std::optional<Document::NodeIndex> attributeTarget;
+		BuildError firstError;
+
+		// Only used when deduplicating: element hashes and reuse counts by node,
+		// and the distinct subtrees seen so far in node order
+		std::vector<std::uint64_t> hashes;
+		std::vector<std::uint32_t> reuses;
+		std::vector<Subtree> subtrees;
+		std::unordered_multimap<std::uint64_t, Document::NodeIndex> subtreesByHash;
+		std::size_t reusedSubtrees = 0;
+		std::size_t removedNodes = 0;
+
+		static std::uint64_t mix(std::uint64_t seed, std::uint64_t value);
+		// Hashes a node's kind, text and attributes, but not its children
+		std::uint64_t hashContent(Document::NodeIndex index) const;
+		std::uint64_t hashNode(Document::NodeIndex index) const;
+		bool equalNodes(Document::NodeIndex a, Document::NodeIndex b) const;
+		bool equalSubtrees(Document::NodeIndex a, Document::NodeIndex b) const;
+
+		// Hashes a closed element and, if an identical subtree already exists,
+		// drops this one from the tables and returns the existing one instead
+		Document::NodeIndex deduplicate(const OpenElement& element);
+
+		// Removes the subtree of the element at index, which is the end of every table
+		void truncate(Document::NodeIndex index, const OpenElement& element);
+
+		// Renders each subtree used more than once into the text pool
+		void cacheSharedSubtrees();
+
+		void fail(BuildError::Code code) {
+			if (!firstError) {
+				firstError.code = code;
+			}
+		}
+
+		Document::TextRange appendText(std::string_view text) {
+			assert(document.textPool.size() + text.size() <= UINT32_MAX);
+			const Document::TextRange range{
+				static_cast<std::uint32_t>(document.textPool.size()),
+				static_cast<std::uint32_t>(text.size())
+			};
+			document.textPool.append(text);
+			return range;
+		}
+
+		Document::TextRange internTag(const char* key, std::string_view tag) {
+			for (const auto& interned : tags) {
+				if ((key != nullptr && interned.key == key) || document.getText(interned.range) == tag) {
+					return interned.range;
+				}
+			}
+			tags.push_back(InternedTag{ key, appendText(tag) });
+			return tags.back().range;
+		}
+
+		Document::NodeIndex appendNode(Document::NodeKind kind, Document::TextRange text) {
+			attributeTarget.reset();
+			const auto index = static_cast<Document::NodeIndex>(document.nodes.size());
+			document.nodes.push_back(Document::Node{
+				kind, text, static_cast<std::uint32_t>(document.attributes.size()), 0, 0, 0 });
+			pending.push_back(index);
+			return index;
+		}
+
+	public:
+		DocumentBuilder() = default;
+		explicit DocumentBuilder(DocumentBuilderOptions options) :
+			options(options)
+		{
+			assert(options.deduplicateSubtrees || !options.cacheSharedSubtrees); // Caching needs deduplication
+		}
+
+		// Reserves the tables up front so building needs no reallocation
+		void reserve(std::size_t nodes, std::size_t attributes, std::size_t textBytes, std::size_t depth = 64) {
+			document.nodes.reserve(nodes);
+			document.childIndices.reserve(nodes);
+			document.attributes.reserve(attributes);
+			document.textPool.reserve(textBytes);
+			openElements.reserve(depth);
+			pending.reserve(nodes < depth * 8 ? nodes : depth * 8);
+		}
+
+		DocumentBuilder& open(std::string_view tag) {
+			return openElement(internTag(nullptr, tag));
+		}
+
+		template <typename Tag>
+		DocumentBuilder& open() {
+			return openElement(internTag(Tag::tag, Tag::tag));
+		}
+
+		// Adds an element with no children or closing tag, e.g. voidElement("br")
+		DocumentBuilder& voidElement(std::string_view tag) {
+			attributeTarget = appendNode(Document::NodeKind::Void, internTag(nullptr, tag));
+			return *this;
+		}
+
+		// Attributes must directly follow their element's open(); any other is dropped
+		DocumentBuilder& attribute(std::string_view name, std::string_view value) {
+			if (!attributeTarget) {
+				fail(BuildError::Code::MisplacedAttribute);
+				return *this;
+			}
+			document.attributes.push_back(Document::Attribute{ appendText(name), appendText(value) });
+			++document.nodes[*attributeTarget].attributeCount;
+			return *this;
+		}
+
+		DocumentBuilder& attribute(const Class<>& c) {
+			return attribute("class", c.getName());
+		}
+		template <fixed_string Name>
+		DocumentBuilder& attribute(const Class<Name>& c) {
+			return attribute("class", c.getName());
+		}
+		DocumentBuilder& attribute(const Id<>& id) {
+			return attribute("id", id.getName());
+		}
+		template <fixed_string Name>
+		DocumentBuilder& attribute(const Id<Name>& id) {
+			return attribute("id", id.getName());
+		}
+
+		DocumentBuilder& text(std::string_view content) {
+			appendNode(Document::NodeKind::Text, appendText(content));
+			return *this;
+		}
+
+		// Adds markup that is written out verbatim
+		DocumentBuilder& raw(std::string_view markup) {
+			appendNode(Document::NodeKind::Raw, appendText(markup));
+			return *this;
+		}
+
+		// A number that cannot be formatted adds no node
+		template <NumericValue T>
+		DocumentBuilder& text(T value, const NumberFormat& format = {}) {
+			char buffer[formattedNumberSize];
+			const char* const end = FormatNumber(buffer, buffer + sizeof(buffer), value, format);
+			if (end == nullptr) {
+				fail(BuildError::Code::InvalidNumber);
+				return *this;
+			}
+			return text(std::string_view(buffer, static_cast<std::size_t>(end - buffer)));
+		}
+
+		template <typename Tag, typename... Content>
+		DocumentBuilder& element(const Content&... content) {
+			open<Tag>();
+			(text(content), ...);
+			return close();
+		}
+
+		// A close() without a matching open() is dropped
+		DocumentBuilder& close() {
+			if (openElements.empty()) {
+				fail(BuildError::Code::UnmatchedClose);
+				return *this;
+			}
+			attributeTarget.reset();
+			const OpenElement element = openElements.back();
+			openElements.pop_back();
+
+			Document::Node& node = document.nodes[element.node];
+			node.firstChild = static_cast<std::uint32_t>(document.childIndices.size());
+			node.childCount = static_cast<std::uint32_t>(pending.size() - element.firstPending);
+			document.childIndices.insert(document.childIndices.end(),
+				pending.begin() + static_cast<std::ptrdiff_t>(element.firstPending), pending.end());
+			pending.resize(element.firstPending);
+			pending.push_back(options.deduplicateSubtrees ? deduplicate(element) : element.node);
+			return *this;
+		}
+
+		// Subtrees replaced by an identical earlier one so far
+		std::size_t getReusedSubtreeCount() const {
+			return reusedSubtrees;
+		}
+		// Nodes those subtrees would have added
+		std::size_t getRemovedNodeCount() const {
+			return removedNodes;
+		}
+
+		// The first misuse since the builder was last finished
+		BuildError getError() const {
+			return firstError;
+		}
+
+		// Finishes the document, closing any elements still open, and stores
+		// the first misuse in error if given. The builder is empty afterwards
+		// and can be reused.
+		Document finish(BuildError* error = nullptr);
+
+	private:
+		DocumentBuilder& openElement(Document::TextRange tag) {
+			const auto node = appendNode(Document::NodeKind::Element, tag);
+			pending.pop_back();
+			openElements.push_back(OpenElement{ node, pending.size(),
+				document.childIndices.size(), document.textPool.size(), tags.size() });
+			attributeTarget = node;
+			if (openElements.size() > document.maxDepth) {
+				document.maxDepth = static_cast<std::uint32_t>(openElements.size());
+			}
+			return *this;
+		}
+	};
+}
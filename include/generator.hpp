@@ -0,0 +1,176 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include "web.hpp"
+
+
+namespace Web {
+
+	// A coroutine that yields children one at a time, so a long list can be
+	// rendered without collecting it first, e.g.
+	//
+	//   Web::Generator<Web::Tr> rows(Cursor& cursor) {
+	//       while (auto row = cursor.next()) {
+	//           co_yield Web::Tr{ Web::Td{ row->name } };
+	//       }
+	//   }
+	//   stream << Web::Table{ Web::Tbody{ rows(cursor) } };
+	//
+	// Each element is rendered as soon as it is yielded and destroyed when the
+	// coroutine resumes. A generator runs once: copies share the same coroutine,
+	// so rendering it a second time renders nothing. Rendering stops pulling
+	// elements as soon as the stream fails.
+	template <typename T>
+	class Generator {
+	public:
+		struct promise_type {
+			const T* current = nullptr;
+			std::exception_ptr error;
+
+			Generator get_return_object() {
+				return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+			std::suspend_always initial_suspend() noexcept {
+				return {};
+			}
+			std::suspend_always final_suspend() noexcept {
+				return {};
+			}
+			// The yielded value lives until the coroutine resumes
+			std::suspend_always yield_value(const T& value) noexcept {
+				current = std::addressof(value);
+				return {};
+			}
+			std::suspend_always yield_value(T&& value) noexcept {
+				current = std::addressof(value);
+				return {};
+			}
+			void return_void() noexcept {}
+			void unhandled_exception() {
+				error = std::current_exception();
+			}
+
+			// Generators only yield
+			template <typename U>
+			std::suspend_never await_transform(U&&) = delete;
+		};
+
+		class iterator {
+			std::coroutine_handle<promise_type> handle;
+
+			void advance() {
+				handle.resume();
+				if (handle.done() && handle.promise().error) {
+					std::rethrow_exception(std::exchange(handle.promise().error, nullptr));
+				}
+			}
+
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const T*;
+			using reference = const T&;
+
+			iterator() = default;
+			explicit iterator(std::coroutine_handle<promise_type> handle) :
+				handle(handle)
+			{
+				advance();
+			}
+
+			reference operator*() const {
+				return *handle.promise().current;
+			}
+			pointer operator->() const {
+				return handle.promise().current;
+			}
+			iterator& operator++() {
+				advance();
+				return *this;
+			}
+			void operator++(int) {
+				++*this;
+			}
+			bool operator==(std::default_sentinel_t) const {
+				return !handle || handle.done();
+			}
+		};
+
+		// Starts the coroutine, or continues where an earlier pass stopped
+		iterator begin() const {
+			if (!state || state->handle.done()) {
+				return iterator();
+			}
+			return iterator(state->handle);
+		}
+		std::default_sentinel_t end() const {
+			return {};
+		}
+
+		// Resumes the coroutine for its next element, or returns nullptr when it has finished
+		const T* next() const {
+			if (!state || state->handle.done()) {
+				return nullptr;
+			}
+			state->handle.resume();
+			if (state->handle.done()) {
+				if (state->handle.promise().error) {
+					std::rethrow_exception(std::exchange(state->handle.promise().error, nullptr));
+				}
+				return nullptr;
+			}
+			return state->handle.promise().current;
+		}
+
+	private:
+		struct State {
+			std::coroutine_handle<promise_type> handle;
+
+			explicit State(std::coroutine_handle<promise_type> handle) :
+				handle(handle)
+			{}
+			State(const State&) = delete;
+			State& operator=(const State&) = delete;
+			~State() {
+				handle.destroy();
+			}
+		};
+
+		// Shared because elements copy their children, and a coroutine can't be copied
+		std::shared_ptr<State> state;
+
+		explicit Generator(std::coroutine_handle<promise_type> handle) :
+			state(std::make_shared<State>(handle))
+		{}
+	};
+
+	template <typename T>
+	struct content_categories<Generator<T>> : content_categories<T> {};
+
+	// Each request for a child resumes the generator, so the index is not needed
+	template <typename T>
+	NodeRef MakeNodeRef(const Generator<T>& items) {
+		return NodeRef{ &items, nullptr, nullptr, [](const void* object, std::size_t /*index*/) -> std::optional<NodeRef> {
+			if (const T* item = static_cast<const Generator<T>*>(object)->next()) {
+				return MakeNodeRef(*item);
+			}
+			return std::nullopt;
+		} };
+	}
+
+	template <typename T>
+	void WriteToStream(std::ostream& stream, const Generator<T>& items) {
+		for (const T& item : items) {
+			WriteToStream(stream, item);
+			if (!stream) {
+				break; // Leave the rest of the sequence ungenerated
+			}
+		}
+	}
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <string_view>
 #include <type_traits>
 
 
@@ -21,3 +23,49 @@ struct contains_duplicates_impl<Arg, Args...>
 template<typename... Args>
 struct contains_duplicates : contains_duplicates_impl<Args...>
 {};
+
+template <std::size_t N>
+struct fixed_string
+{
+	char value[N]{};
+
+	constexpr fixed_string() = default;
+
+	constexpr fixed_string(const char (&str)[N])
+	{
+		for (std::size_t i = 0; i < N; ++i) {
+			value[i] = str[i];
+		}
+	}
+
+	constexpr std::size_t size() const { return N - 1; }
+	constexpr const char* data() const { return value; }
+	constexpr std::string_view view() const { return std::string_view(value, N - 1); }
+
+	template <std::size_t M>
+	constexpr fixed_string<N + M - 1> operator+(const fixed_string<M>& other) const
+	{
+		fixed_string<N + M - 1> result;
+		for (std::size_t i = 0; i < N - 1; ++i) {
+			result.value[i] = value[i];
+		}
+		for (std::size_t i = 0; i < M; ++i) {
+			result.value[N - 1 + i] = other.value[i];
+		}
+		return result;
+	}
+
+	constexpr bool operator==(const fixed_string&) const = default;
+};
+
+template <std::size_t N>
+fixed_string(const char (&)[N]) -> fixed_string<N>;
+
+constexpr std::size_t constexpr_strlen(const char* str)
+{
+	std::size_t length = 0;
+	while (str[length] != '\0') {
+		++length;
+	}
+	return length;
+}
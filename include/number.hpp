@@ -0,0 +1,144 @@
+#pragma once
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+
+
+namespace Web {
+
+	// Arithmetic types rendered as numbers. Character types keep rendering as text.
+	template <typename T>
+	concept NumericValue = std::is_arithmetic_v<std::decay_t<T>>
+		&& !std::is_same_v<std::decay_t<T>, bool>
+		&& !std::is_same_v<std::decay_t<T>, char>
+		&& !std::is_same_v<std::decay_t<T>, signed char>
+		&& !std::is_same_v<std::decay_t<T>, unsigned char>
+		&& !std::is_same_v<std::decay_t<T>, wchar_t>
+		&& !std::is_same_v<std::decay_t<T>, char8_t>
+		&& !std::is_same_v<std::decay_t<T>, char16_t>
+		&& !std::is_same_v<std::decay_t<T>, char32_t>;
+
+	struct NumberFormat {
+		// Digits after the decimal point, or -1 for the shortest exact representation
+		int precision = -1;
+		// Inserted between groups of three integer digits when not '\0'
+		char thousandsSeparator = '\0';
+	};
+
+	// Large enough for a fixed format double with maximum exponent and precision,
+	// including thousands separators
+	constexpr std::size_t formattedNumberSize = 768;
+
+	namespace detail {
+		// Inserts separators between groups of three integer digits in place.
+		// Returns the new end, or nullptr when the buffer is too small.
+		inline char* groupThousands(char* first, char* last, char* capacityEnd, char separator) {
+			char* digits = first;
+			if (digits != last && *digits == '-') {
+				++digits;
+			}
+			char* integerEnd = digits;
+			while (integerEnd != last && *integerEnd >= '0' && *integerEnd <= '9') {
+				++integerEnd;
+			}
+
+			const std::size_t integerDigits = static_cast<std::size_t>(integerEnd - digits);
+			const std::size_t separators = integerDigits == 0 ? 0 : (integerDigits - 1) / 3;
+			if (static_cast<std::size_t>(capacityEnd - last) < separators) {
+				return nullptr;
+			}
+
+			// Shift from the back so every character moves at most once
+			char* source = last;
+			char* target = last + separators;
+			while (source != integerEnd) {
+				*--target = *--source;
+			}
+			std::size_t written = 0;
+			while (source != digits) {
+				if (written != 0 && written % 3 == 0) {
+					*--target = separator;
+				}
+				*--target = *--source;
+				++written;
+			}
+			return last + separators;
+		}
+	}
+
+	// Formats a number with std::to_chars into [first, last) without consulting
+	// any locale. Returns the end of the text, or nullptr when it does not fit.
+	template <NumericValue T>
+	char* FormatNumber(char* first, char* last, T value, const NumberFormat& format = {}) {
+		std::to_chars_result result;
+
+		if constexpr (std::is_floating_point_v<T>) {
+			if (format.precision >= 0) {
+				result = std::to_chars(first, last, value, std::chars_format::fixed, format.precision);
+			}
+			else {
+				result = std::to_chars(first, last, value);
+			}
+		}
+		else {
+			result = std::to_chars(first, last, value);
+			if (result.ec == std::errc{} && format.precision > 0) {
+				if (last - result.ptr <= format.precision) {
+					return nullptr;
+				}
+				*result.ptr++ = '.';
+				for (int i = 0; i < format.precision; ++i) {
+					*result.ptr++ = '0';
+				}
+			}
+		}
+
+		if (result.ec != std::errc{}) {
+			return nullptr;
+		}
+		if (format.thousandsSeparator != '\0') {
+			return detail::groupThousands(first, result.ptr, last, format.thousandsSeparator);
+		}
+		return result.ptr;
+	}
+
+	// Formats a number into a stack buffer and writes it with a single stream.write
+	template <NumericValue T>
+	void WriteNumber(std::ostream& stream, T value, const NumberFormat& format = {}) {
+		char buffer[formattedNumberSize];
+		const char* const end = FormatNumber(buffer, buffer + sizeof(buffer), value, format);
+		if (end == nullptr) {
+			stream.setstate(std::ios_base::failbit);
+			return;
+		}
+		stream.write(buffer, end - buffer);
+	}
+
+	// A number child with explicit formatting, e.g.
+	// Web::Number{ price, { .precision = 2, .thousandsSeparator = ',' } }
+	template <NumericValue T>
+	class Number {
+		T value;
+		NumberFormat format;
+	public:
+		explicit Number(T value, NumberFormat format = {}) :
+			value(value),
+			format(format)
+		{}
+
+		T getValue() const {
+			return value;
+		}
+		const NumberFormat& getFormat() const {
+			return format;
+		}
+	};
+
+	template <NumericValue T>
+	std::ostream& operator<<(std::ostream& stream, const Number<T>& number) {
+		WriteNumber(stream, number.getValue(), number.getFormat());
+		return stream;
+	}
+}
@@ -0,0 +1,416 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "document.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WEB_PARSER_SSE2 1
+#else
+#define WEB_PARSER_SSE2 0
+#endif
+
+
+namespace Web {
+
+	struct ParseError {
+		enum class Code {
+			None,
+			UnexpectedEndTag, // An end tag that does not match the open element
+			UnclosedElement, // The input ended with elements still open
+			MalformedTag,
+			MalformedEntity, // An '&' that does not start a character reference
+			UnterminatedComment
+		};
+
+		Code code = Code::None;
+		std::size_t offset = 0;
+
+		explicit operator bool() const {
+			return code != Code::None;
+		}
+	};
+
+	namespace detail {
+		// Returns the first position in [first, last) holding one of the given
+		// characters, or last. Scans 16 bytes at a time where SSE2 is available.
+		template <char... Chars>
+		const char* findFirstOf(const char* first, const char* last) {
+#if WEB_PARSER_SSE2
+			while (last - first >= 16) {
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+				__m128i matches = _mm_setzero_si128();
+				((matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(Chars)))), ...);
+				const auto mask = static_cast<unsigned>(_mm_movemask_epi8(matches));
+				if (mask != 0) {
+					return first + std::countr_zero(mask);
+				}
+				first += 16;
+			}
+#endif
+			while (first != last && ((*first != Chars) && ...)) {
+				++first;
+			}
+			return first;
+		}
+
+		constexpr bool isSpace(char c) {
+			return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+		}
+		// Ends a tag or attribute name
+		constexpr bool isNameEnd(char c) {
+			return isSpace(c) || c == '>' || c == '/' || c == '=' || c == '"' || c == '\'' || c == '<';
+		}
+		constexpr bool isAlpha(char c) {
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+		}
+		constexpr bool isDigit(char c) {
+			return c >= '0' && c <= '9';
+		}
+		constexpr bool isHexDigit(char c) {
+			return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+		}
+		constexpr char toLower(char c) {
+			return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+		}
+
+		constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+			if (a.size() != b.size()) {
+				return false;
+			}
+			for (std::size_t i = 0; i < a.size(); ++i) {
+				if (toLower(a[i]) != toLower(b[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr bool isVoidElement(std::string_view tag) {
+			// Every void element name has between 2 and 6 characters
+			if (tag.size() < 2 || tag.size() > 6) {
+				return false;
+			}
+			constexpr std::string_view voidElements[] = {
+				"area", "base", "br", "col", "embed", "hr", "img", "input",
+				"link", "meta", "source", "track", "wbr"
+			};
+			for (auto element : voidElements) {
+				if (equalsIgnoreCase(tag, element)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Elements whose content is not markup and runs until the matching end tag
+		constexpr bool isRawTextElement(std::string_view tag) {
+			return equalsIgnoreCase(tag, "script") || equalsIgnoreCase(tag, "style");
+		}
+
+		// Checks a character reference starting at the '&' and returns its end,
+		// or nullptr when it is malformed
+		inline const char* skipEntity(const char* p, const char* last) {
+			++p;
+			if (p != last && *p == '#') {
+				++p;
+				const bool hex = p != last && (*p == 'x' || *p == 'X');
+				if (hex) {
+					++p;
+				}
+				const char* digits = p;
+				while (p != last && (hex ? isHexDigit(*p) : isDigit(*p))) {
+					++p;
+				}
+				if (p == digits) {
+					return nullptr;
+				}
+			}
+			else {
+				if (p == last || !isAlpha(*p)) {
+					return nullptr;
+				}
+				while (p != last && (isAlpha(*p) || isDigit(*p))) {
+					++p;
+				}
+			}
+			return p != last && *p == ';' ? p + 1 : nullptr;
+		}
+
+		// Validates all character references in a run of text or an attribute value
+		inline const char* findMalformedEntity(const char* first, const char* last) {
+			for (;;) {
+				first = findFirstOf<'&'>(first, last);
+				if (first == last) {
+					return nullptr;
+				}
+				const char* end = skipEntity(first, last);
+				if (end == nullptr) {
+					return first;
+				}
+				first = end;
+			}
+		}
+	}
+
+	// Does nothing with the tokens, for validation only
+	struct NullHtmlHandler {
+		void text(std::string_view) {}
+		void raw(std::string_view) {}
+		void startTag(std::string_view) {}
+		void attribute(std::string_view, std::string_view) {}
+		void voidTag(std::string_view) {}
+		void endTag(std::string_view) {}
+	};
+
+	// A tokenizer for well formed HTML. It checks that every element is closed
+	// (void elements excepted), tags are well formed and every '&' starts a
+	// character reference, and reports tokens to a handler with the members of
+	// NullHtmlHandler. Elements are never closed implicitly.
+	template <typename Handler>
+	ParseError tokenizeHtml(std::string_view html, Handler& handler) {
+		using detail::isSpace;
+		const char* const begin = html.data();
+		const char* const last = begin + html.size();
+		const char* p = begin;
+
+		std::vector<std::string_view> openElements;
+		openElements.reserve(32);
+
+		auto error = [begin](ParseError::Code code, const char* at) {
+			return ParseError{ code, static_cast<std::size_t>(at - begin) };
+		};
+
+		while (p != last) {
+			// Text up to the next tag, checking character references in the same pass
+			const char* textEnd = p;
+			for (;;) {
+				textEnd = detail::findFirstOf<'<', '&'>(textEnd, last);
+				if (textEnd == last || *textEnd == '<') {
+					break;
+				}
+				const char* entityEnd = detail::skipEntity(textEnd, last);
+				if (entityEnd == nullptr) {
+					return error(ParseError::Code::MalformedEntity, textEnd);
+				}
+				textEnd = entityEnd;
+			}
+			if (textEnd != p) {
+				handler.text(std::string_view(p, static_cast<std::size_t>(textEnd - p)));
+				p = textEnd;
+				if (p == last) {
+					break;
+				}
+			}
+
+			const char* tagStart = p++;
+			if (p == last) {
+				return error(ParseError::Code::MalformedTag, tagStart);
+			}
+
+			// Comments, doctypes and other declarations are passed through
+			if (*p == '!') {
+				const bool comment = last - p >= 3 && p[1] == '-' && p[2] == '-';
+				const std::string_view terminator = comment ? "-->" : ">";
+				const auto end = html.find(terminator, static_cast<std::size_t>(p - begin) + (comment ? 3 : 1));
+				if (end == std::string_view::npos) {
+					return error(comment ? ParseError::Code::UnterminatedComment : ParseError::Code::MalformedTag, tagStart);
+				}
+				p = begin + end + terminator.size();
+				handler.raw(std::string_view(tagStart, static_cast<std::size_t>(p - tagStart)));
+				continue;
+			}
+
+			const bool endTag = *p == '/';
+			if (endTag) {
+				++p;
+			}
+			const char* nameStart = p;
+			if (p == last || !detail::isAlpha(*p)) {
+				return error(ParseError::Code::MalformedTag, tagStart);
+			}
+			while (p != last && !detail::isNameEnd(*p)) {
+				++p;
+			}
+			const std::string_view name(nameStart, static_cast<std::size_t>(p - nameStart));
+
+			if (endTag) {
+				while (p != last && isSpace(*p)) {
+					++p;
+				}
+				if (p == last || *p != '>') {
+					return error(ParseError::Code::MalformedTag, tagStart);
+				}
+				++p;
+				if (openElements.empty() || !detail::equalsIgnoreCase(openElements.back(), name)) {
+					return error(ParseError::Code::UnexpectedEndTag, tagStart);
+				}
+				openElements.pop_back();
+				handler.endTag(name);
+				continue;
+			}
+
+			const bool isVoid = detail::isVoidElement(name);
+			if (isVoid) {
+				handler.voidTag(name);
+			}
+			else {
+				handler.startTag(name);
+			}
+
+			// Attributes
+			bool selfClosing = false;
+			for (;;) {
+				while (p != last && isSpace(*p)) {
+					++p;
+				}
+				if (p == last) {
+					return error(ParseError::Code::MalformedTag, tagStart);
+				}
+				if (*p == '>') {
+					++p;
+					break;
+				}
+				if (*p == '/') {
+					if (last - p < 2 || p[1] != '>') {
+						return error(ParseError::Code::MalformedTag, p);
+					}
+					selfClosing = true;
+					p += 2;
+					break;
+				}
+
+				const char* attributeStart = p;
+				while (p != last && !detail::isNameEnd(*p)) {
+					++p;
+				}
+				if (p == attributeStart) {
+					return error(ParseError::Code::MalformedTag, p);
+				}
+				const std::string_view attributeName(attributeStart, static_cast<std::size_t>(p - attributeStart));
+
+				std::string_view value;
+				if (p != last && *p == '=') {
+					++p;
+					if (p == last) {
+						return error(ParseError::Code::MalformedTag, p);
+					}
+					if (*p == '"' || *p == '\'') {
+						const char quote = *p++;
+						const char* valueEnd = quote == '"'
+							? detail::findFirstOf<'"'>(p, last)
+							: detail::findFirstOf<'\''>(p, last);
+						if (valueEnd == last) {
+							return error(ParseError::Code::MalformedTag, attributeStart);
+						}
+						value = std::string_view(p, static_cast<std::size_t>(valueEnd - p));
+						p = valueEnd + 1;
+					}
+					else {
+						const char* valueStart = p;
+						while (p != last && !isSpace(*p) && *p != '>' && *p != '"' && *p != '\'' && *p != '<' && *p != '=' && *p != '`') {
+							++p;
+						}
+						if (p == valueStart) {
+							return error(ParseError::Code::MalformedTag, p);
+						}
+						value = std::string_view(valueStart, static_cast<std::size_t>(p - valueStart));
+					}
+					if (const char* bad = detail::findMalformedEntity(value.data(), value.data() + value.size())) {
+						return error(ParseError::Code::MalformedEntity, bad);
+					}
+				}
+				handler.attribute(attributeName, value);
+			}
+
+			if (isVoid) {
+				continue;
+			}
+			if (selfClosing) {
+				handler.endTag(name);
+				continue;
+			}
+
+			if (detail::isRawTextElement(name)) {
+				// Find the matching end tag, ignoring markup in between
+				const char* contentStart = p;
+				for (;;) {
+					p = detail::findFirstOf<'<'>(p, last);
+					if (p == last) {
+						return error(ParseError::Code::UnclosedElement, tagStart);
+					}
+					// The name must end there, so </scripts does not end a script
+					if (last - p > static_cast<std::ptrdiff_t>(name.size() + 2) && p[1] == '/'
+						&& detail::equalsIgnoreCase(std::string_view(p + 2, name.size()), name)
+						&& (isSpace(p[name.size() + 2]) || p[name.size() + 2] == '/' || p[name.size() + 2] == '>')) {
+						break;
+					}
+					++p;
+				}
+				if (p != contentStart) {
+					handler.raw(std::string_view(contentStart, static_cast<std::size_t>(p - contentStart)));
+				}
+				openElements.push_back(name);
+				continue;
+			}
+
+			openElements.push_back(name);
+		}
+
+		if (!openElements.empty()) {
+			return error(ParseError::Code::UnclosedElement, last);
+		}
+		return ParseError{};
+	}
+
+	ParseError validateHtml(std::string_view html);
+
+	// Builds a Document from the tokens of tokenizeHtml
+	class DocumentHtmlHandler {
+		DocumentBuilder& builder;
+	public:
+		explicit DocumentHtmlHandler(DocumentBuilder& builder) :
+			builder(builder)
+		{}
+
+		void text(std::string_view content) { builder.text(content); }
+		void raw(std::string_view markup) { builder.raw(markup); }
+		void startTag(std::string_view tag) { builder.open(tag); }
+		void voidTag(std::string_view tag) { builder.voidElement(tag); }
+		void endTag(std::string_view /*tag*/) { builder.close(); }
+
+		void attribute(std::string_view name, std::string_view value);
+	};
+
+	// Instantiated once, in src/parser.cpp
+	extern template ParseError tokenizeHtml(std::string_view html, NullHtmlHandler& handler);
+	extern template ParseError tokenizeHtml(std::string_view html, DocumentHtmlHandler& handler);
+
+	// Parses well formed HTML into a Document
+	std::optional<Document> parseHtml(std::string_view html, ParseError* error = nullptr);
+
+	// A fragment of existing markup, checked once and then written verbatim
+	class RawHtml {
+		std::string html;
+
+		explicit RawHtml(std::string html) :
+			html(std::move(html))
+		{}
+
+	public:
+		static std::optional<RawHtml> create(std::string html, ParseError* error = nullptr);
+
+		const std::string& getHtml() const {
+			return html;
+		}
+	};
+
+	std::ostream& operator<<(std::ostream& stream, const RawHtml& raw);
+}
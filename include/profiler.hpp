@@ -0,0 +1,263 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "content-model.hpp"
+
+// Set WEB_PROFILE=1 to compile in render profiling hooks. With the default of 0
+// they compile to nothing. The setting must be the same in every translation
+// unit of a program.
+#ifndef WEB_PROFILE
+#define WEB_PROFILE 0
+#endif
+
+
+namespace Web {
+
+	inline constexpr bool profilingEnabled = WEB_PROFILE != 0;
+
+#if WEB_PROFILE
+	// Records where rendering spends its time. While a profiler is alive it
+	// collects every render on its thread as a tree of frames, one per element
+	// type or named Profiled component at each position, e.g.
+	//
+	//   Web::RenderProfiler profiler;
+	//   stream << page;
+	//   std::cout << profiler.foldedStacks(); // input for flamegraph.pl
+	//
+	// Bytes are measured with tellp(), so they are only known for streams
+	// that report their position, such as std::ostringstream.
+	class RenderProfiler {
+	public:
+		struct Frame {
+			std::string name;
+			std::size_t parent;
+			std::size_t firstChild = npos;
+			std::size_t nextSibling = npos;
+			std::uint64_t calls = 0;
+			std::chrono::nanoseconds total{ 0 };
+			std::chrono::nanoseconds children{ 0 };
+			std::uint64_t bytes = 0;
+			std::uint64_t childCount = 0; // Elements rendered directly inside this one
+		};
+
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+		RenderProfiler() :
+			previous(current())
+		{
+			frames.push_back(Frame{ "root", npos });
+			current() = this;
+		}
+		RenderProfiler(const RenderProfiler&) = delete;
+		RenderProfiler& operator=(const RenderProfiler&) = delete;
+		~RenderProfiler() {
+			current() = previous;
+		}
+
+		static RenderProfiler*& current() {
+			thread_local RenderProfiler* profiler = nullptr;
+			return profiler;
+		}
+
+		void enter(std::string_view name, std::ostream& stream) {
+			const std::size_t parent = open.empty() ? 0 : open.back().frame;
+			++frames[parent].childCount;
+			const std::size_t frame = findOrAddChild(parent, name);
+			++frames[frame].calls;
+			open.push_back(OpenFrame{ frame, stream.tellp(), std::chrono::steady_clock::now() });
+		}
+
+		void exit(std::ostream& stream) {
+			const auto end = std::chrono::steady_clock::now();
+			const OpenFrame opened = open.back();
+			open.pop_back();
+
+			Frame& frame = frames[opened.frame];
+			const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - opened.start);
+			frame.total += elapsed;
+			frames[frame.parent].children += elapsed;
+			const auto position = stream.tellp();
+			if (opened.position != std::streampos(-1) && position != std::streampos(-1)) {
+				frame.bytes += static_cast<std::uint64_t>(position - opened.position);
+			}
+		}
+
+		const std::vector<Frame>& getFrames() const {
+			return frames;
+		}
+
+		// One line per call stack with its self time in nanoseconds, e.g.
+		// "html;body;div 1200", in the folded format read by flamegraph tools
+		std::string foldedStacks() const {
+			std::string result;
+			std::vector<std::size_t> path;
+			for (std::size_t i = 1; i < frames.size(); ++i) {
+				path.clear();
+				for (std::size_t f = i; f != 0; f = frames[f].parent) {
+					path.push_back(f);
+				}
+				for (auto it = path.rbegin(); it != path.rend(); ++it) {
+					result += frames[*it].name;
+					result += it + 1 == path.rend() ? ' ' : ';';
+				}
+				result += std::to_string(selfTime(frames[i]).count());
+				result += '\n';
+			}
+			return result;
+		}
+
+		// Totals per element type or component name, wherever it appeared
+		std::string jsonSummary() const {
+			struct Totals {
+				std::uint64_t calls = 0;
+				std::chrono::nanoseconds total{ 0 };
+				std::chrono::nanoseconds self{ 0 };
+				std::uint64_t bytes = 0;
+				std::uint64_t childCount = 0;
+			};
+			std::map<std::string_view, Totals> byName;
+			for (std::size_t i = 1; i < frames.size(); ++i) {
+				Totals& totals = byName[frames[i].name];
+				totals.calls += frames[i].calls;
+				totals.self += selfTime(frames[i]);
+				totals.bytes += frames[i].bytes;
+				totals.childCount += frames[i].childCount;
+				if (!hasAncestorNamed(i, frames[i].name)) {
+					totals.total += frames[i].total; // Recursion would count nested time twice
+				}
+			}
+
+			std::string result = "{\"nodes\":[";
+			bool first = true;
+			for (const auto& [name, totals] : byName) {
+				result += first ? "" : ",";
+				first = false;
+				result += "{\"name\":\"";
+				appendEscaped(result, name);
+				result += "\",\"calls\":" + std::to_string(totals.calls);
+				result += ",\"totalNs\":" + std::to_string(totals.total.count());
+				result += ",\"selfNs\":" + std::to_string(totals.self.count());
+				result += ",\"bytes\":" + std::to_string(totals.bytes);
+				result += ",\"children\":" + std::to_string(totals.childCount) + "}";
+			}
+			result += "]}";
+			return result;
+		}
+
+	private:
+		struct OpenFrame {
+			std::size_t frame;
+			std::streampos position;
+			std::chrono::steady_clock::time_point start;
+		};
+
+		RenderProfiler* previous;
+		std::vector<Frame> frames;
+		std::vector<OpenFrame> open;
+
+		std::size_t findOrAddChild(std::size_t parent, std::string_view name) {
+			std::size_t* link = &frames[parent].firstChild;
+			while (*link != npos) {
+				if (frames[*link].name == name) {
+					return *link;
+				}
+				link = &frames[*link].nextSibling;
+			}
+			const std::size_t index = frames.size();
+			*link = index; // Taken before push_back may reallocate frames
+			frames.push_back(Frame{ std::string(name), parent });
+			return index;
+		}
+
+		static std::chrono::nanoseconds selfTime(const Frame& frame) {
+			return frame.total - frame.children;
+		}
+
+		bool hasAncestorNamed(std::size_t frame, std::string_view name) const {
+			for (std::size_t f = frames[frame].parent; f != 0 && f != npos; f = frames[f].parent) {
+				if (frames[f].name == name) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		static void appendEscaped(std::string& out, std::string_view text) {
+			for (char c : text) {
+				if (c == '"' || c == '\\') {
+					out += '\\';
+					out += c;
+				}
+				else if (static_cast<unsigned char>(c) < 0x20) {
+					out += ' ';
+				}
+				else {
+					out += c;
+				}
+			}
+		}
+	};
+
+	// Entered by every element as it renders; does nothing without a profiler
+	class ProfileScope {
+		RenderProfiler* profiler;
+		std::ostream& stream;
+	public:
+		ProfileScope(std::string_view name, std::ostream& stream) :
+			profiler(RenderProfiler::current()),
+			stream(stream)
+		{
+			if (profiler) {
+				profiler->enter(name, stream);
+			}
+		}
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+		~ProfileScope() {
+			if (profiler) {
+				profiler->exit(stream);
+			}
+		}
+	};
+#endif
+
+	// Profiles a subtree under a name of its own, e.g. Web::Profiled{ "navigation", Web::Nav{ ... } }.
+	// Without WEB_PROFILE it renders the subtree and nothing else, and does not
+	// keep the name.
+	template <typename T>
+	class Profiled {
+#if WEB_PROFILE
+		std::string name;
+#endif
+		T child;
+	public:
+		Profiled([[maybe_unused]] std::string_view name, T child) :
+#if WEB_PROFILE
+			name(name),
+#endif
+			child(std::move(child))
+		{}
+
+		// Empty without WEB_PROFILE
+		std::string_view getName() const {
+#if WEB_PROFILE
+			return name;
+#else
+			return {};
+#endif
+		}
+		const T& getChild() const {
+			return child;
+		}
+	};
+
+	template <typename T>
+	struct content_categories<Profiled<T>> : content_categories<T> {};
+}
@@ -0,0 +1,277 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "parser.hpp"
+
+#if defined(_WIN32)
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+
+namespace Web {
+
+	struct RawFileOptions {
+		// Check the file's modification time, size and inode on every render and
+		// remap it when they change. A changed file that fails validation keeps
+		// the previous contents, and is not loaded again until it changes again.
+		bool reloadOnChange = false;
+	};
+
+	struct RawFileError {
+		enum class Code {
+			None,
+			CannotOpen,
+			CannotMap,
+			InvalidHtml
+		};
+
+		Code code = Code::None;
+		ParseError html; // Set when code is InvalidHtml
+
+		explicit operator bool() const {
+			return code != Code::None;
+		}
+	};
+
+	// A large static HTML file, e.g. a footer or an SVG sprite sheet. The file is
+	// mapped into memory and validated once; rendering writes the mapped bytes
+	// directly, with no per-render reads or copies.
+	//
+	// Update mapped files by replacing them (write a new file and rename it over
+	// the old one). Truncating a file in place changes bytes that are already
+	// mapped, and reading past the new end of the file raises SIGBUS.
+	class RawFile {
+		// What identifies one version of a file on disk. A file replaced by a
+		// rename within the timestamp resolution still gets a new inode.
+		struct Version {
+			std::int64_t modified = 0;
+			std::uint64_t size = 0;
+			std::uint64_t inode = 0;
+
+			bool operator==(const Version&) const = default;
+		};
+
+	public:
+		// The validated contents of the file at one point in time
+		class Mapping {
+			const char* data = nullptr;
+			std::size_t size = 0;
+			Version version;
+#if defined(_WIN32)
+			std::string contents;
+#endif
+			friend class RawFile;
+
+		public:
+			Mapping() = default;
+			Mapping(const Mapping&) = delete;
+			Mapping& operator=(const Mapping&) = delete;
+
+			~Mapping() {
+#if !defined(_WIN32)
+				if (size != 0) {
+					::munmap(const_cast<char*>(data), size);
+				}
+#endif
+			}
+
+			std::string_view view() const {
+				return std::string_view(data, size);
+			}
+
+#if !defined(_WIN32)
+			// The bytes as an iovec for writev/sendmsg
+			::iovec slice() const {
+				return ::iovec{ const_cast<char*>(data), size };
+			}
+#endif
+		};
+
+		static std::optional<RawFile> open(std::string path, RawFileOptions options = {}, RawFileError* error = nullptr) {
+			RawFileError result;
+			auto mapping = load(path, result);
+			if (error) {
+				*error = result;
+			}
+			if (!mapping) {
+				return std::nullopt;
+			}
+			return RawFile(std::make_shared<Source>(std::move(path), options, std::move(mapping)));
+		}
+
+		// The current contents. Holding the pointer keeps them mapped across a reload.
+		std::shared_ptr<const Mapping> snapshot() const {
+			if (source->options.reloadOnChange) {
+				reloadIfChanged();
+			}
+			return source->mapping.load(std::memory_order_acquire);
+		}
+
+		// Remaps the file if it changed on disk. Returns false when the file could
+		// not be reloaded, in which case the previous contents are kept. A version
+		// that failed to load is remembered and not tried again.
+		bool reloadIfChanged() const {
+			const auto current = source->mapping.load(std::memory_order_acquire);
+			const auto version = fileVersion(source->path);
+			if (!version) {
+				return false;
+			}
+			if (*version == current->version) {
+				return true;
+			}
+			const auto failed = source->failedVersion.load(std::memory_order_acquire);
+			if (failed && *failed == *version) {
+				return false;
+			}
+			// Remember the version load() itself saw, as the file may have been
+			// replaced again since the stat above
+			RawFileError error;
+			std::optional<Version> loaded;
+			auto mapping = load(source->path, error, &loaded);
+			if (!mapping) {
+				if (loaded) {
+					source->failedVersion.store(std::make_shared<const Version>(*loaded), std::memory_order_release);
+				}
+				return false;
+			}
+			source->mapping.store(std::move(mapping), std::memory_order_release);
+			return true;
+		}
+
+		const std::string& getPath() const {
+			return source->path;
+		}
+
+		std::ostream& streamOut(std::ostream& stream) const {
+			const auto mapping = snapshot();
+			const auto bytes = mapping->view();
+			return stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		}
+
+	private:
+		struct Source {
+			Source(std::string path, RawFileOptions options, std::shared_ptr<const Mapping> mapping) :
+				path(std::move(path)),
+				options(options),
+				mapping(std::move(mapping))
+			{}
+
+			const std::string path;
+			const RawFileOptions options;
+			std::atomic<std::shared_ptr<const Mapping>> mapping;
+			// The last version on disk that could not be loaded
+			std::atomic<std::shared_ptr<const Version>> failedVersion;
+		};
+
+		// Copies share the source, so a reload is seen by every copy
+		std::shared_ptr<Source> source;
+
+		explicit RawFile(std::shared_ptr<Source> source) :
+			source(std::move(source))
+		{}
+
+#if !defined(_WIN32)
+		static Version versionOf(const struct ::stat& info) {
+			return Version{
+				static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec,
+				static_cast<std::uint64_t>(info.st_size),
+				static_cast<std::uint64_t>(info.st_ino)
+			};
+		}
+#endif
+
+		static std::optional<Version> fileVersion(const std::string& path) {
+#if defined(_WIN32)
+			std::error_code error;
+			const auto time = std::filesystem::last_write_time(path, error);
+			if (error) {
+				return std::nullopt;
+			}
+			const auto size = std::filesystem::file_size(path, error);
+			if (error) {
+				return std::nullopt;
+			}
+			return Version{ static_cast<std::int64_t>(time.time_since_epoch().count()), static_cast<std::uint64_t>(size), 0 };
+#else
+			struct ::stat info {};
+			if (::stat(path.c_str(), &info) != 0) {
+				return std::nullopt;
+			}
+			return versionOf(info);
+#endif
+		}
+
+		// Sets loaded to the version of the file it opened, once that is known
+		static std::shared_ptr<const Mapping> load(const std::string& path, RawFileError& error, std::optional<Version>* loaded = nullptr) {
+			auto mapping = std::make_shared<Mapping>();
+#if defined(_WIN32)
+			std::ifstream file(path, std::ios::binary);
+			const auto version = fileVersion(path);
+			if (!file || !version) {
+				error.code = RawFileError::Code::CannotOpen;
+				return nullptr;
+			}
+			std::stringstream contents;
+			contents << file.rdbuf();
+			mapping->contents = contents.str();
+			mapping->data = mapping->contents.data();
+			mapping->size = mapping->contents.size();
+			mapping->version = *version;
+			if (loaded) {
+				*loaded = *version;
+			}
+#else
+			const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0) {
+				error.code = RawFileError::Code::CannotOpen;
+				return nullptr;
+			}
+			struct ::stat info {};
+			if (::fstat(fd, &info) != 0) {
+				::close(fd);
+				error.code = RawFileError::Code::CannotOpen;
+				return nullptr;
+			}
+			mapping->version = versionOf(info);
+			if (loaded) {
+				*loaded = mapping->version;
+			}
+			if (info.st_size > 0) {
+				void* data = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+				if (data == MAP_FAILED) {
+					::close(fd);
+					error.code = RawFileError::Code::CannotMap;
+					return nullptr;
+				}
+				mapping->data = static_cast<const char*>(data);
+				mapping->size = static_cast<std::size_t>(info.st_size);
+			}
+			::close(fd);
+#endif
+			error.html = validateHtml(mapping->view());
+			if (error.html) {
+				error.code = RawFileError::Code::InvalidHtml;
+				return nullptr;
+			}
+			return mapping;
+		}
+	};
+
+	inline std::ostream& operator<<(std::ostream& stream, const RawFile& file) {
+		return file.streamOut(stream);
+	}
+}
@@ -0,0 +1,259 @@
+#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+
+namespace Web {
+
+	// A streambuf that appends to a std::string, writing straight into its spare
+	// capacity. Rendering into a string reserved up front does not allocate.
+	class StringBuffer : public std::streambuf {
+		std::string& target;
+
+		void growBy(std::size_t count) {
+			const std::size_t used = static_cast<std::size_t>(pptr() - target.data());
+			target.resize(std::max(target.capacity() * 2, used + count));
+			target.resize(target.capacity());
+			setp(target.data() + used, target.data() + target.size());
+		}
+
+	public:
+		explicit StringBuffer(std::string& target) :
+			target(target)
+		{
+			const std::size_t used = target.size();
+			target.resize(target.capacity());
+			setp(target.data() + used, target.data() + target.size());
+		}
+		StringBuffer(const StringBuffer&) = delete;
+		StringBuffer& operator=(const StringBuffer&) = delete;
+
+		// Trims the string back to what was written
+		~StringBuffer() override {
+			target.resize(size());
+		}
+
+		// The length of the string including everything written so far
+		std::size_t size() const {
+			return static_cast<std::size_t>(pptr() - target.data());
+		}
+
+		// Everything written so far, valid until the next write
+		std::string_view view() const {
+			return std::string_view(target.data(), size());
+		}
+
+		// Discards everything written, keeping the capacity
+		void clear() {
+			setp(target.data(), target.data() + target.size());
+		}
+
+	protected:
+		int_type overflow(int_type c) override {
+			if (traits_type::eq_int_type(c, traits_type::eof())) {
+				return traits_type::not_eof(c);
+			}
+			growBy(1);
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+			return c;
+		}
+
+		std::streamsize xsputn(const char* s, std::streamsize count) override {
+			const auto length = static_cast<std::size_t>(count);
+			if (static_cast<std::size_t>(epptr() - pptr()) < length) {
+				growBy(length);
+			}
+			std::memcpy(pptr(), s, length);
+			setp(pptr() + length, epptr());
+			return count;
+		}
+	};
+
+	// Appends the HTML for node to out and returns it
+	template <typename T>
+	std::string& render(std::string& out, const T& node) {
+		StringBuffer buffer(out);
+		std::ostream stream(&buffer);
+		stream << node;
+		return out;
+	}
+
+	struct RenderError {
+		enum class Code {
+			None,
+			SinkFull, // The sink reached its size limit; it holds what fitted
+			OutOfMemory, // The sink could not grow
+			StreamFailed // A child put the stream into a failed state
+		};
+
+		Code code = Code::None;
+
+		explicit operator bool() const {
+			return code != Code::None;
+		}
+	};
+
+	// A streambuf over memory owned by the caller, e.g. a stack array. Writes
+	// past the end are cut off and reported as RenderError::Code::SinkFull.
+	class FixedBuffer : public std::streambuf {
+		char* const first;
+		RenderError::Code code = RenderError::Code::None;
+
+	public:
+		FixedBuffer(char* data, std::size_t capacity) :
+			first(data)
+		{
+			setp(data, data + capacity);
+		}
+		FixedBuffer(const FixedBuffer&) = delete;
+		FixedBuffer& operator=(const FixedBuffer&) = delete;
+
+		std::size_t size() const {
+			return static_cast<std::size_t>(pptr() - first);
+		}
+
+		std::string_view view() const {
+			return std::string_view(first, size());
+		}
+
+		RenderError error() const {
+			return RenderError{ code };
+		}
+
+		// Discards everything written and any error
+		void clear() {
+			setp(first, epptr());
+			code = RenderError::Code::None;
+		}
+
+	protected:
+		int_type overflow(int_type c) override {
+			if (traits_type::eq_int_type(c, traits_type::eof())) {
+				return traits_type::not_eof(c);
+			}
+			code = RenderError::Code::SinkFull;
+			return traits_type::eof();
+		}
+
+		std::streamsize xsputn(const char* s, std::streamsize count) override {
+			const auto available = static_cast<std::streamsize>(epptr() - pptr());
+			if (count > available) {
+				code = RenderError::Code::SinkFull;
+				count = available;
+			}
+			std::memcpy(pptr(), s, static_cast<std::size_t>(count));
+			setp(pptr() + count, epptr());
+			return count;
+		}
+	};
+
+	// A streambuf that grows a block from std::malloc with std::realloc, for
+	// builds without exceptions, where a failed allocation in std::string ends
+	// the process. A failed realloc is reported as RenderError::Code::OutOfMemory
+	// and growing past maxSize as RenderError::Code::SinkFull; either way the
+	// buffer keeps what was written before.
+	class ReallocBuffer : public std::streambuf {
+		char* buffer = nullptr;
+		std::size_t maxSize;
+		RenderError::Code code = RenderError::Code::None;
+
+		bool grow(std::size_t count) {
+			const std::size_t used = size();
+			const std::size_t capacity = static_cast<std::size_t>(epptr() - buffer);
+			if (count > maxSize - used) {
+				code = RenderError::Code::SinkFull;
+				return false;
+			}
+			const std::size_t newCapacity = std::min(std::max({ capacity * 2, used + count, std::size_t{ 256 } }), maxSize);
+			char* const grown = static_cast<char*>(std::realloc(buffer, newCapacity));
+			if (grown == nullptr) {
+				code = RenderError::Code::OutOfMemory;
+				return false;
+			}
+			buffer = grown;
+			setp(buffer + used, buffer + newCapacity);
+			return true;
+		}
+
+	public:
+		explicit ReallocBuffer(std::size_t maxSize = std::numeric_limits<std::size_t>::max()) :
+			maxSize(maxSize)
+		{}
+		ReallocBuffer(const ReallocBuffer&) = delete;
+		ReallocBuffer& operator=(const ReallocBuffer&) = delete;
+
+		~ReallocBuffer() override {
+			std::free(buffer);
+		}
+
+		std::size_t size() const {
+			return static_cast<std::size_t>(pptr() - buffer);
+		}
+
+		// Everything written so far, valid until the next write
+		std::string_view view() const {
+			return std::string_view(buffer, size());
+		}
+
+		RenderError error() const {
+			return RenderError{ code };
+		}
+
+		// Discards everything written and any error, keeping the block
+		void clear() {
+			setp(buffer, epptr());
+			code = RenderError::Code::None;
+		}
+
+	protected:
+		int_type overflow(int_type c) override {
+			if (traits_type::eq_int_type(c, traits_type::eof())) {
+				return traits_type::not_eof(c);
+			}
+			if (!grow(1)) {
+				return traits_type::eof();
+			}
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+			return c;
+		}
+
+		std::streamsize xsputn(const char* s, std::streamsize count) override {
+			auto length = static_cast<std::size_t>(count);
+			if (static_cast<std::size_t>(epptr() - pptr()) < length && !grow(length)) {
+				length = static_cast<std::size_t>(epptr() - pptr());
+			}
+			std::memcpy(pptr(), s, length);
+			setp(pptr() + length, epptr());
+			return static_cast<std::streamsize>(length);
+		}
+	};
+
+	// Renders node into a FixedBuffer or ReallocBuffer and reports failures
+	// through the return value, so it can be used without exceptions. Rendering
+	// allocates nothing itself unless WEB_VALIDATE or WEB_PROFILE is on, or a
+	// Document is nested more than 63 elements deep; if that allocation fails
+	// the render reports StreamFailed.
+	template <typename Sink, typename T>
+		requires std::derived_from<Sink, std::streambuf>
+			&& requires (const Sink& sink) { { sink.error() } -> std::same_as<RenderError>; }
+	[[nodiscard]] RenderError render(Sink& sink, const T& node) {
+		std::ostream stream(&sink);
+		stream << node;
+		if (const RenderError error = sink.error()) {
+			return error;
+		}
+		if (!stream) {
+			return RenderError{ RenderError::Code::StreamFailed };
+		}
+		return RenderError{};
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "web.hpp"
+
+
+namespace Web {
+
+	// An immutable subtree built once and shared between documents, e.g.
+	//
+	//   static const Web::Shared footer{ Web::Footer{ Web::P{ "(c) Example" } } };
+	//   stream << Web::Html{ Web::Body{ content, footer } };
+	//
+	// Copying it copies a reference-counted pointer. The subtree is rendered
+	// the first time any copy is rendered, and every render after that writes
+	// the cached bytes. Rendering from several threads at once is safe.
+	// Runtime validation sees the subtree only on that first render.
+	template <typename T>
+	class Shared {
+		struct State {
+			const T node;
+			std::once_flag rendered;
+			std::string bytes;
+
+			explicit State(T node) :
+				node(std::move(node))
+			{}
+		};
+
+		std::shared_ptr<State> state;
+
+	public:
+		explicit Shared(T node) :
+			state(std::make_shared<State>(std::move(node)))
+		{}
+		// Moving copies, so a Shared always has a subtree and is never left empty
+		Shared(const Shared&) = default;
+		Shared& operator=(const Shared&) = default;
+
+		const T& get() const {
+			return state->node;
+		}
+
+		// The rendered subtree, rendering it on the first call
+		std::string_view bytes() const {
+			State& shared = *state;
+			std::call_once(shared.rendered, [&shared] {
+				std::ostringstream stream;
+				stream << shared.node;
+				shared.bytes = std::move(stream).str();
+			});
+			return shared.bytes;
+		}
+	};
+
+	template <typename T>
+	struct content_categories<Shared<T>> : content_categories<T> {};
+
+	template <typename T>
+	void WriteToStream(std::ostream& stream, const Shared<T>& shared) {
+		const std::string_view bytes = shared.bytes();
+		stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+}
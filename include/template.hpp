@@ -0,0 +1,167 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include "web.hpp"
+
+
+namespace Web {
+
+	namespace detail {
+		// A unique address per type, used to check a slot against its template argument
+		template <typename T>
+		const void* slotTypeKey() {
+			static const char key = 0;
+			return &key;
+		}
+	}
+
+	// Records everything written to it as static byte runs interleaved with slot markers
+	class SegmentRecorder : public std::streambuf {
+	public:
+		static constexpr std::size_t noSlot = std::numeric_limits<std::size_t>::max();
+
+		struct Segment {
+			std::size_t offset;
+			std::size_t length;
+			std::size_t slot;
+			const void* slotType;
+		};
+
+		void markSlot(std::size_t slot, const void* slotType) {
+			segments.push_back(Segment{ bytes.size(), 0, slot, slotType });
+		}
+
+		std::string& getBytes() {
+			return bytes;
+		}
+		std::vector<Segment>& getSegments() {
+			return segments;
+		}
+
+	protected:
+		std::streamsize xsputn(const char* s, std::streamsize count) override {
+			append(s, static_cast<std::size_t>(count));
+			return count;
+		}
+
+		int_type overflow(int_type ch) override {
+			if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+				const char c = traits_type::to_char_type(ch);
+				append(&c, 1);
+			}
+			return traits_type::not_eof(ch);
+		}
+
+	private:
+		void append(const char* s, std::size_t count) {
+			if (segments.empty() || segments.back().slot != noSlot) {
+				segments.push_back(Segment{ bytes.size(), 0, noSlot, nullptr });
+			}
+			bytes.append(s, count);
+			segments.back().length += count;
+		}
+
+		std::string bytes;
+		std::vector<Segment> segments;
+	};
+
+	// A placeholder for the Nth argument of a Template, which must have type T
+	template <std::size_t N, typename T>
+	class Slot {};
+
+	// A slot is checked against the content model as the type it will hold
+	template <std::size_t N, typename T>
+	struct content_categories<Slot<N, T>> : content_categories<T> {};
+
+	template <std::size_t N, typename T>
+	std::ostream& operator<<(std::ostream& stream, const Slot<N, T>& /*slot*/) {
+		// Slots can only be rendered while compiling a Template; anywhere else
+		// the stream fails rather than silently dropping the slot
+		auto recorder = dynamic_cast<SegmentRecorder*>(stream.rdbuf());
+		if (recorder) {
+			recorder->markSlot(N, detail::slotTypeKey<T>());
+		}
+		else {
+			stream.setstate(std::ios_base::failbit);
+		}
+		return stream;
+	}
+
+	// A document rendered once into static byte runs and slots. Rendering
+	// fills the slots from the arguments without building a tree, e.g.
+	//
+	//   const Web::Template<std::string> page{ Web::Html{ Web::Body{ Web::H1{ Web::Slot<0, std::string>{} } } } };
+	//   page.render(stream, title);
+	template <typename... Args>
+	class Template {
+		using SlotWriter = void(*)(std::ostream&, const void*);
+
+		struct Segment {
+			std::size_t offset;
+			std::size_t length;
+			std::size_t slot;
+		};
+
+		std::string bytes;
+		std::vector<Segment> segments;
+
+		template <std::size_t... I>
+		static constexpr std::array<SlotWriter, sizeof...(Args)> makeWriters(std::index_sequence<I...>) {
+			return { [](std::ostream& stream, const void* value) {
+				WriteToStream(stream, *static_cast<const std::tuple_element_t<I, std::tuple<Args...>>*>(value));
+			}... };
+		}
+		static constexpr auto writers = makeWriters(std::index_sequence_for<Args...>{});
+
+	public:
+		// Throws std::invalid_argument when a slot has no matching template
+		// argument or a different type from it, as rendering would then read
+		// the wrong argument
+		template <typename Tree>
+		explicit Template(const Tree& tree) {
+			SegmentRecorder recorder;
+			std::ostream stream(&recorder);
+			stream << tree;
+
+			const std::array<const void*, sizeof...(Args)> slotTypes{ detail::slotTypeKey<Args>()... };
+			segments.reserve(recorder.getSegments().size());
+			for (const auto& segment : recorder.getSegments()) {
+				if (segment.slot != SegmentRecorder::noSlot) {
+					if (segment.slot >= sizeof...(Args)) {
+						throw std::invalid_argument("Template slot has no matching template argument");
+					}
+					if (segment.slotType != slotTypes[segment.slot]) {
+						throw std::invalid_argument("Template slot type does not match its template argument");
+					}
+				}
+				segments.push_back(Segment{ segment.offset, segment.length, segment.slot });
+			}
+			bytes = std::move(recorder.getBytes());
+		}
+
+		void render(std::ostream& sink, const Args&... args) const {
+			const std::array<const void*, sizeof...(Args)> values{ static_cast<const void*>(&args)... };
+			for (const auto& segment : segments) {
+				if (segment.slot == SegmentRecorder::noSlot) {
+					sink.write(bytes.data() + segment.offset, static_cast<std::streamsize>(segment.length));
+				}
+				else {
+					writers[segment.slot](sink, values[segment.slot]);
+				}
+			}
+		}
+
+		// The number of static runs and slots the document compiled to
+		std::size_t segmentCount() const {
+			return segments.size();
+		}
+	};
+}
@@ -0,0 +1,431 @@
+#pragma once
+#ifndef _WIN32
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <streambuf>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define WEB_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#else
+#define WEB_HAS_IO_URING 0
+#endif
+
+
+namespace Web {
+
+#if WEB_HAS_IO_URING
+	namespace detail {
+		// The minimum of io_uring over raw syscalls: one submission and one
+		// completion ring, mapped into this process
+		class Uring {
+			int ringFd = -1;
+			void* ringMemory = MAP_FAILED;
+			std::size_t ringSize = 0;
+			io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+			std::size_t sqesSize = 0;
+
+			unsigned* sqTail = nullptr;
+			unsigned sqMask = 0;
+			unsigned* sqArray = nullptr;
+			unsigned* cqHead = nullptr;
+			unsigned* cqTail = nullptr;
+			unsigned cqMask = 0;
+			io_uring_cqe* cqes = nullptr;
+			unsigned pendingSubmissions = 0;
+
+			static unsigned* field(void* base, std::uint32_t offset) {
+				return reinterpret_cast<unsigned*>(static_cast<char*>(base) + offset);
+			}
+
+		public:
+			Uring() = default;
+			Uring(const Uring&) = delete;
+			Uring& operator=(const Uring&) = delete;
+			~Uring() {
+				if (sqes != MAP_FAILED) {
+					::munmap(sqes, sqesSize);
+				}
+				if (ringMemory != MAP_FAILED) {
+					::munmap(ringMemory, ringSize);
+				}
+				if (ringFd >= 0) {
+					::close(ringFd);
+				}
+			}
+
+			// Returns false when the kernel does not offer io_uring, e.g. under a seccomp filter
+			bool setup(unsigned entries) {
+				io_uring_params params{};
+				const long fd = ::syscall(__NR_io_uring_setup, entries, &params);
+				if (fd < 0) {
+					return false;
+				}
+				ringFd = static_cast<int>(fd);
+				if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+					return false; // Kernels before 5.4; not worth a second mapping
+				}
+
+				ringSize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+					params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+				ringMemory = ::mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+				sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+				sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+				if (ringMemory == MAP_FAILED || sqes == MAP_FAILED) {
+					return false;
+				}
+
+				sqTail = field(ringMemory, params.sq_off.tail);
+				sqMask = *field(ringMemory, params.sq_off.ring_mask);
+				sqArray = field(ringMemory, params.sq_off.array);
+				cqHead = field(ringMemory, params.cq_off.head);
+				cqTail = field(ringMemory, params.cq_off.tail);
+				cqMask = *field(ringMemory, params.cq_off.ring_mask);
+				cqes = reinterpret_cast<io_uring_cqe*>(static_cast<char*>(ringMemory) + params.cq_off.cqes);
+				return true;
+			}
+
+			bool registerBuffers(const iovec* buffers, unsigned count) {
+				return ::syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+			}
+
+			// The next submission entry, cleared. The caller must not queue more
+			// entries than the ring was set up with before calling enter().
+			io_uring_sqe& next() {
+				const unsigned tail = *sqTail + pendingSubmissions;
+				const unsigned index = tail & sqMask;
+				sqArray[index] = index;
+				++pendingSubmissions;
+				std::memset(&sqes[index], 0, sizeof(io_uring_sqe));
+				return sqes[index];
+			}
+
+			// Submits queued entries and waits for at least minComplete completions
+			bool enter(unsigned minComplete) {
+				std::atomic_ref<unsigned>(*sqTail).store(*sqTail + pendingSubmissions, std::memory_order_release);
+				unsigned toSubmit = pendingSubmissions;
+				pendingSubmissions = 0;
+				while (true) {
+					const long submitted = ::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete,
+						minComplete > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+					if (submitted >= 0) {
+						toSubmit -= static_cast<unsigned>(submitted);
+						if (toSubmit == 0) {
+							return true;
+						}
+					}
+					else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+						return false;
+					}
+				}
+			}
+
+			template <typename Callback>
+			void reap(Callback&& callback) {
+				unsigned head = *cqHead;
+				const unsigned tail = std::atomic_ref<unsigned>(*cqTail).load(std::memory_order_acquire);
+				for (; head != tail; ++head) {
+					const io_uring_cqe& cqe = cqes[head & cqMask];
+					callback(cqe.user_data, cqe.res);
+				}
+				std::atomic_ref<unsigned>(*cqHead).store(head, std::memory_order_release);
+			}
+		};
+	}
+#endif
+
+	struct UringOptions {
+		// Buffers rendered output is written into; each is one write
+		unsigned bufferCount = 8;
+		std::size_t bufferSize = 64 * 1024;
+		// Full buffers are submitted together as a linked chain of this many
+		unsigned batchSize = 4;
+		// Use plain write() even where io_uring is available
+		bool forceFallback = false;
+	};
+
+	// A streambuf that renders straight into buffers registered with io_uring
+	// and writes them to a file, pipe or socket, e.g.
+	//
+	//   Web::UringBuffer buffer(fd);
+	//   std::ostream stream(&buffer);
+	//   stream << page << std::flush;
+	//
+	// Full buffers are batched and submitted as linked IORING_OP_WRITE_FIXED
+	// requests, so rendering continues while the kernel writes. Writes to a
+	// regular file go to explicit offsets from the current position; a pipe or
+	// socket has one chain in flight at a time to keep the stream in order. Where io_uring is not available
+	// each full buffer is written with write() instead. The descriptor must be
+	// blocking and is not closed.
+	class UringBuffer : public std::streambuf {
+		struct Buffer {
+			std::size_t length = 0;
+			std::size_t written = 0;
+			std::uint64_t offset = 0;
+			bool inFlight = false;
+		};
+
+		int fd;
+		UringOptions options;
+		std::unique_ptr<char[]> storage;
+		std::vector<Buffer> buffers;
+		// Buffers handed over for writing, oldest first, by index
+		std::vector<unsigned> queue;
+		std::size_t queueStart = 0;
+		unsigned current = 0;
+		unsigned unsubmitted = 0;
+		std::uint64_t fileOffset = 0;
+		bool seekable = false;
+		bool failed = false;
+		std::size_t submissions = 0;
+#if WEB_HAS_IO_URING
+		detail::Uring ring;
+		bool uring = false;
+		bool fixedBuffers = false;
+		unsigned inFlight = 0;
+#endif
+
+		char* bufferData(unsigned index) const {
+			return storage.get() + index * options.bufferSize;
+		}
+
+		bool isBusy(unsigned index) const {
+			const Buffer& buffer = buffers[index];
+			return buffer.written < buffer.length;
+		}
+
+		void writeDirect(unsigned index) {
+			Buffer& buffer = buffers[index];
+			while (buffer.written < buffer.length && !failed) {
+				const ssize_t result = ::write(fd, bufferData(index) + buffer.written, buffer.length - buffer.written);
+				if (result >= 0) {
+					buffer.written += static_cast<std::size_t>(result);
+				}
+				else if (errno != EINTR) {
+					failed = true;
+				}
+			}
+			++submissions;
+		}
+
+#if WEB_HAS_IO_URING
+		// Submits every queued buffer that still has bytes to write and is not in
+		// flight. A pipe or socket gets one chain at a time: a short write cancels
+		// the rest of its chain, and the remainder must go out before anything later.
+		void submitQueued() {
+			if (!seekable && inFlight > 0) {
+				return;
+			}
+			unsigned count = 0;
+			io_uring_sqe* last = nullptr;
+			for (std::size_t i = queueStart; i < queue.size(); ++i) {
+				const unsigned index = queue[i];
+				Buffer& buffer = buffers[index];
+				if (buffer.inFlight || !isBusy(index)) {
+					continue;
+				}
+				io_uring_sqe& sqe = ring.next();
+				sqe.opcode = fixedBuffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+				sqe.fd = fd;
+				sqe.addr = reinterpret_cast<std::uint64_t>(bufferData(index) + buffer.written);
+				sqe.len = static_cast<std::uint32_t>(buffer.length - buffer.written);
+				sqe.off = seekable ? buffer.offset + buffer.written : 0;
+				sqe.buf_index = fixedBuffers ? static_cast<std::uint16_t>(index) : 0;
+				sqe.user_data = index;
+				sqe.flags = IOSQE_IO_LINK;
+				last = &sqe;
+				buffer.inFlight = true;
+				++count;
+			}
+			inFlight += count;
+			if (last) {
+				last->flags &= static_cast<std::uint8_t>(~IOSQE_IO_LINK);
+				failed |= !ring.enter(0);
+				++submissions;
+			}
+			unsubmitted = 0;
+		}
+
+		void complete(std::uint64_t index, std::int32_t result) {
+			Buffer& buffer = buffers[static_cast<std::size_t>(index)];
+			buffer.inFlight = false;
+			--inFlight;
+			if (result > 0) {
+				buffer.written += static_cast<std::size_t>(result);
+			}
+			else if (result == 0 || (result != -ECANCELED && result != -EINTR && result != -EAGAIN)) {
+				failed = true; // A short chain is resubmitted; anything else is an error
+			}
+		}
+
+		// Waits for at least one completion, then resubmits anything a short write cut off
+		void waitForCompletion() {
+			failed |= !ring.enter(1);
+			ring.reap([this](std::uint64_t index, std::int32_t result) { complete(index, result); });
+			if (!failed) {
+				submitQueued();
+			}
+		}
+#endif
+
+		void popWritten() {
+			while (queueStart < queue.size() && !isBusy(queue[queueStart])) {
+				++queueStart;
+			}
+			if (queueStart == queue.size()) {
+				queue.clear();
+				queueStart = 0;
+			}
+		}
+
+		// Hands the current buffer over for writing and moves on to the next free one
+		void retireCurrent() {
+			Buffer& buffer = buffers[current];
+			buffer.length = static_cast<std::size_t>(pptr() - pbase());
+			buffer.written = 0;
+			if (buffer.length > 0) {
+				buffer.offset = fileOffset;
+				fileOffset += buffer.length;
+				queue.push_back(current);
+#if WEB_HAS_IO_URING
+				if (uring) {
+					if (++unsubmitted >= options.batchSize) {
+						submitQueued();
+					}
+				}
+				else
+#endif
+				{
+					writeDirect(current);
+				}
+				current = (current + 1) % options.bufferCount;
+			}
+
+			while (isBusy(current) && !failed) {
+#if WEB_HAS_IO_URING
+				if (unsubmitted > 0) {
+					submitQueued();
+				}
+				waitForCompletion();
+#endif
+				popWritten();
+			}
+			popWritten();
+			setp(bufferData(current), bufferData(current) + options.bufferSize);
+		}
+
+		// Writes everything handed over so far and waits for it
+		void drain() {
+#if WEB_HAS_IO_URING
+			if (uring) {
+				if (unsubmitted > 0) {
+					submitQueued();
+				}
+				while (queueStart < queue.size() && !failed) {
+					waitForCompletion();
+					popWritten();
+				}
+				// Collect requests still in flight after a failure before buffers can be reused
+				while (failed && inFlight > 0) {
+					if (!ring.enter(1)) {
+						break;
+					}
+					ring.reap([this](std::uint64_t index, std::int32_t result) { complete(index, result); });
+				}
+			}
+#endif
+			for (auto& buffer : buffers) {
+				buffer.length = buffer.written = 0;
+			}
+			queue.clear();
+			queueStart = 0;
+		}
+
+	public:
+		explicit UringBuffer(int fd, UringOptions options = {}) :
+			fd(fd),
+			options(options),
+			storage(new char[options.bufferCount * options.bufferSize]),
+			buffers(options.bufferCount)
+		{
+			assert(options.bufferCount > 0 && options.batchSize > 0);
+			struct stat info {};
+			seekable = ::fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+			if (seekable) {
+				const off_t position = ::lseek(fd, 0, SEEK_CUR);
+				fileOffset = position < 0 ? 0 : static_cast<std::uint64_t>(position);
+			}
+#if WEB_HAS_IO_URING
+			if (!options.forceFallback && ring.setup(options.bufferCount)) {
+				uring = true;
+				std::vector<iovec> vectors(options.bufferCount);
+				for (unsigned i = 0; i < options.bufferCount; ++i) {
+					vectors[i] = iovec{ bufferData(i), options.bufferSize };
+				}
+				// Registration can fail under a low RLIMIT_MEMLOCK; plain writes still work
+				fixedBuffers = ring.registerBuffers(vectors.data(), options.bufferCount);
+			}
+#endif
+			setp(bufferData(0), bufferData(0) + options.bufferSize);
+		}
+		UringBuffer(const UringBuffer&) = delete;
+		UringBuffer& operator=(const UringBuffer&) = delete;
+		~UringBuffer() override {
+			sync();
+		}
+
+		// Whether writes go through io_uring rather than write()
+		bool usesUring() const {
+#if WEB_HAS_IO_URING
+			return uring;
+#else
+			return false;
+#endif
+		}
+		bool hasFailed() const {
+			return failed;
+		}
+		// io_uring_enter or write calls made so far, to compare batching
+		std::size_t getSubmissionCount() const {
+			return submissions;
+		}
+
+	protected:
+		int_type overflow(int_type c) override {
+			if (failed) {
+				return traits_type::eof();
+			}
+			retireCurrent();
+			if (!traits_type::eq_int_type(c, traits_type::eof())) {
+				*pptr() = traits_type::to_char_type(c);
+				pbump(1);
+			}
+			return failed ? traits_type::eof() : traits_type::not_eof(c);
+		}
+
+		int sync() override {
+			if (!failed) {
+				retireCurrent();
+			}
+			drain();
+			if (seekable && !failed) {
+				::lseek(fd, static_cast<off_t>(fileOffset), SEEK_SET); // Explicit offsets do not move the file position
+			}
+			return failed ? -1 : 0;
+		}
+	};
+}
+#endif
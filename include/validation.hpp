@@ -0,0 +1,239 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include "content-model.hpp"
+
+// Runtime validation of rendered documents, on by default in debug builds. It
+// catches what compile time checks cannot see, such as duplicate ids across the
+// elements of a std::vector. With WEB_VALIDATE=0 (or NDEBUG) it compiles to nothing.
+// The setting must be the same in every translation unit of a program.
+#ifndef WEB_VALIDATE
+#ifdef NDEBUG
+#define WEB_VALIDATE 0
+#else
+#define WEB_VALIDATE 1
+#endif
+#endif
+
+
+namespace Web {
+
+	inline constexpr bool validationEnabled = WEB_VALIDATE != 0;
+
+	struct ValidationError {
+		enum class Code {
+			DuplicateId,
+			InvalidNesting,
+			InvalidAttributeValue
+		};
+
+		Code code;
+		std::string_view subject; // The id, tag or attribute value at fault
+	};
+
+	using ValidationHandler = void(*)(const ValidationError&);
+
+	namespace detail {
+		// Defined in src/validation.cpp, so there is one handler per program
+		void defaultValidationHandler(const ValidationError& error);
+		std::atomic<ValidationHandler>& validationHandler();
+		void reportValidationError(ValidationError::Code code, std::string_view subject);
+
+		constexpr std::uint64_t fnv1a(std::string_view text) {
+			std::uint64_t hash = 14695981039346656037ull;
+			for (char c : text) {
+				hash ^= static_cast<unsigned char>(c);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+	}
+
+	// Replaces the handler called for each validation error. The default prints
+	// the error and asserts. Returns the previous handler.
+	ValidationHandler setValidationHandler(ValidationHandler handler);
+
+#if WEB_VALIDATE
+	// An open addressing set of the ids seen in one document. The strings are not
+	// copied as the elements outlive the render. Small documents fit in the inline
+	// table and never allocate.
+	class IdSet {
+		struct Entry {
+			std::uint64_t hash;
+			std::string_view id;
+		};
+
+		static constexpr std::size_t inlineCapacity = 32;
+		Entry inlineEntries[inlineCapacity]{};
+		std::unique_ptr<Entry[]> heapEntries;
+		Entry* entries = inlineEntries;
+		std::size_t capacity = inlineCapacity;
+		std::size_t count = 0;
+
+		// Returns false if the id was already present
+		static bool place(Entry* table, std::size_t tableCapacity, std::uint64_t hash, std::string_view id) {
+			for (std::size_t i = hash & (tableCapacity - 1);; i = (i + 1) & (tableCapacity - 1)) {
+				Entry& entry = table[i];
+				if (entry.id.data() == nullptr) {
+					entry = Entry{ hash, id };
+					return true;
+				}
+				if (entry.hash == hash && entry.id == id) {
+					return false;
+				}
+			}
+		}
+
+		void grow() {
+			const std::size_t newCapacity = capacity * 2;
+			auto table = std::make_unique<Entry[]>(newCapacity);
+			for (std::size_t i = 0; i < capacity; ++i) {
+				if (entries[i].id.data() != nullptr) {
+					place(table.get(), newCapacity, entries[i].hash, entries[i].id);
+				}
+			}
+			heapEntries = std::move(table);
+			entries = heapEntries.get();
+			capacity = newCapacity;
+		}
+
+	public:
+		IdSet() = default;
+		IdSet(const IdSet&) = delete;
+		IdSet& operator=(const IdSet&) = delete;
+
+		// Returns false if the id was already in the set
+		bool insert(std::string_view id) {
+			if ((count + 1) * 2 > capacity) {
+				grow();
+			}
+			// Empty ids are reported as invalid, so a null data pointer can mark free slots
+			if (id.data() == nullptr) {
+				id = std::string_view("", 0);
+			}
+			const bool inserted = place(entries, capacity, detail::fnv1a(id), id);
+			count += inserted ? 1 : 0;
+			return inserted;
+		}
+
+		// Empties the set, keeping any table it has grown
+		void clear() {
+			for (std::size_t i = 0; i < capacity; ++i) {
+				entries[i] = Entry{};
+			}
+			count = 0;
+		}
+
+		std::size_t size() const {
+			return count;
+		}
+	};
+
+	// The state of one document while it renders: its ids and open elements.
+	// There is one per thread, reused by each render so validation does not
+	// allocate once it has warmed up.
+	class ValidationContext {
+		IdSet ids;
+		// The innermost element's permitted content. Elements that permit anything
+		// are transparent and pass their parent's rules through.
+		ContentCategories permitted = Content::Any;
+		ContentCategories forbidden = Content::None;
+		bool active = false;
+
+		friend class ValidationScope;
+
+		static ValidationContext& instance() {
+			thread_local ValidationContext context;
+			return context;
+		}
+
+	public:
+		// The context of the document rendering on this thread, if any
+		static ValidationContext* current() {
+			ValidationContext& context = instance();
+			return context.active ? &context : nullptr;
+		}
+
+		void addId(std::string_view id) {
+			if (!ids.insert(id)) {
+				detail::reportValidationError(ValidationError::Code::DuplicateId, id);
+			}
+		}
+	};
+
+	// Entered by every element as it renders. The outermost element of a render
+	// owns the context, so each document is validated on its own.
+	class ValidationScope {
+		ValidationContext* context;
+		bool outermost;
+		ContentCategories parentPermitted;
+		ContentCategories parentForbidden;
+
+	public:
+		ValidationScope(std::string_view tag, ContentCategories categories, ContentCategories permitted, ContentCategories forbidden) :
+			context(&ValidationContext::instance()),
+			outermost(!context->active)
+		{
+			if (outermost) {
+				context->ids.clear();
+				context->permitted = Content::Any;
+				context->forbidden = Content::None;
+				context->active = true;
+			}
+
+			parentPermitted = context->permitted;
+			parentForbidden = context->forbidden;
+			if (categories != Content::Any && parentPermitted != Content::Any
+				&& ((categories & parentPermitted) == 0 || (categories & parentForbidden) != 0)) {
+				detail::reportValidationError(ValidationError::Code::InvalidNesting, tag);
+			}
+			if (permitted != Content::Any) {
+				context->permitted = permitted;
+			}
+			// Forbidden content stays forbidden for every descendant, e.g. no
+			// <a> anywhere inside an <a>
+			context->forbidden |= forbidden;
+		}
+
+		ValidationScope(const ValidationScope&) = delete;
+		ValidationScope& operator=(const ValidationScope&) = delete;
+
+		~ValidationScope() {
+			context->permitted = parentPermitted;
+			context->forbidden = parentForbidden;
+			if (outermost) {
+				context->active = false;
+			}
+		}
+	};
+#endif
+
+	// Checks an id for uniqueness within the document being rendered and for syntax
+	inline void ValidateId([[maybe_unused]] std::string_view id) {
+#if WEB_VALIDATE
+		bool valid = !id.empty();
+		for (char c : id) {
+			valid = valid && c != ' ' && c != '\t' && c != '\n' && c != '\r' && c != '\f' && c != '"';
+		}
+		if (!valid) {
+			detail::reportValidationError(ValidationError::Code::InvalidAttributeValue, id);
+		}
+		if (auto context = ValidationContext::current()) {
+			context->addId(id);
+		}
+#endif
+	}
+
+	// Checks that a quoted attribute value cannot end its quotes early
+	inline void ValidateAttributeValue([[maybe_unused]] std::string_view value) {
+#if WEB_VALIDATE
+		if (value.find('"') != std::string_view::npos) {
+			detail::reportValidationError(ValidationError::Code::InvalidAttributeValue, value);
+		}
+#endif
+	}
+}
@@ -1,59 +1,278 @@
 #pragma once
-#include <any>
+#include <array>
 #include <tuple>
 #include <iostream>
 #include <vector>
 #include <optional>
 #include <cassert>
+#include <new>
+#include <string>
+#include <string_view>
+#include <concepts>
+#include <type_traits>
+#include <utility>
 #include "meta.hpp"
+#include "number.hpp"
+#include "content-model.hpp"
+#include "validation.hpp"
+#include "profiler.hpp"
 
 
 namespace Web {
 
-	class Class {
+	// Collects markup during constant evaluation, see renderStatic
+	class StaticWriter {
+		std::string text;
+
+	public:
+		constexpr void write(std::string_view markup) {
+			text.append(markup);
+		}
+		constexpr void put(char c) {
+			text.push_back(c);
+		}
+
+		template <std::integral T>
+		constexpr void writeInteger(T value) {
+			using Unsigned = std::make_unsigned_t<T>;
+			Unsigned magnitude = static_cast<Unsigned>(value);
+			if (value < 0) {
+				put('-');
+				magnitude = static_cast<Unsigned>(0 - magnitude);
+			}
+			char digits[24]{};
+			std::size_t first = sizeof(digits);
+			do {
+				digits[--first] = static_cast<char>('0' + magnitude % 10);
+				magnitude /= 10;
+			} while (magnitude != 0);
+			write(std::string_view(digits + first, sizeof(digits) - first));
+		}
+
+		constexpr std::string take() {
+			return std::move(text);
+		}
+	};
+
+	namespace detail {
+		// Not constexpr, so renderStatic fails to compile when it reaches a
+		// child that can only be rendered at runtime
+		inline void onlyRenderableAtRuntime() {}
+	}
+
+	// Writes a child during constant evaluation. Elements, attributes, strings,
+	// characters, integers and vectors of those can be written this way.
+	template <typename T>
+	constexpr void WriteStatic(StaticWriter& writer, const T& data) {
+		if constexpr (requires { data.writeStatic(writer); }) {
+			data.writeStatic(writer);
+		}
+		else if constexpr (std::is_same_v<T, char>) {
+			writer.put(data);
+		}
+		else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+			writer.write(std::string_view(data));
+		}
+		else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+			writer.writeInteger(data);
+		}
+		else {
+			detail::onlyRenderableAtRuntime();
+		}
+	}
+	template <typename T>
+	constexpr void WriteStatic(StaticWriter& writer, const std::vector<T>& data) {
+		for (const auto& d : data) {
+			WriteStatic(writer, d);
+		}
+	}
+	template <typename T>
+	constexpr void WriteStatic(StaticWriter& writer, const Profiled<T>& profiled) {
+		WriteStatic(writer, profiled.getChild());
+	}
+
+	template <fixed_string... Name>
+	class Class;
+
+	template <>
+	class Class<> {
 		std::string name;
 	public:
-		explicit Class(std::string name) :
+		using key = Class<>;
+
+		constexpr explicit Class(std::string name) :
 			name(std::move(name))
 		{}
-		const std::string& getName() const {
+		// Also usable in renderStatic, where GCC 12 can't move from a
+		// std::string parameter
+		constexpr explicit Class(const char* name) :
+			name(name)
+		{}
+		constexpr const std::string& getName() const {
 			return name;
 		}
+
+		constexpr void writeStatic(StaticWriter& writer) const {
+			writer.write("class=\"");
+			writer.write(name);
+			writer.put('"');
+		}
 	};
-	std::ostream& operator<<(std::ostream& stream, const Class& c) {
+	Class(std::string) -> Class<>;
+	Class(const char*) -> Class<>;
+
+	inline std::ostream& operator<<(std::ostream& stream, const Class<>& c) {
+		ValidateAttributeValue(c.getName());
 		return stream << "class=\"" << c.getName() << "\"";
 	}
 
-	class Id {
+	// A class attribute known at compile time, e.g. Class<"center">
+	template <fixed_string Name>
+	class Class<Name> {
+	public:
+		using key = Class<>;
+		static constexpr auto text = fixed_string{ " class=\"" } + Name + fixed_string{ "\"" };
+
+		static constexpr std::string_view getName() {
+			return Name.view();
+		}
+
+		constexpr void writeStatic(StaticWriter& writer) const {
+			writer.write(text.view().substr(1));
+		}
+	};
+	template <fixed_string Name>
+	std::ostream& operator<<(std::ostream& stream, const Class<Name>& /*c*/) {
+		return stream.write(Class<Name>::text.data() + 1, Class<Name>::text.size() - 1);
+	}
+
+	template <fixed_string... Name>
+	class Id;
+
+	template <>
+	class Id<> {
 		std::string name;
 	public:
-		explicit Id(std::string name) :
+		using key = Id<>;
+
+		constexpr explicit Id(std::string name) :
 			name(std::move(name))
 		{}
-		const std::string& getName() const {
+		// Also usable in renderStatic, where GCC 12 can't move from a
+		// std::string parameter
+		constexpr explicit Id(const char* name) :
+			name(name)
+		{}
+		constexpr const std::string& getName() const {
 			return name;
 		}
+
+		constexpr void writeStatic(StaticWriter& writer) const {
+			writer.write("id=\"");
+			writer.write(name);
+			writer.put('"');
+		}
 	};
-	std::ostream& operator<<(std::ostream& stream, const Id& id) {
+	Id(std::string) -> Id<>;
+	Id(const char*) -> Id<>;
+
+	inline std::ostream& operator<<(std::ostream& stream, const Id<>& id) {
+		ValidateId(id.getName());
 		return stream << "id=\"" << id.getName() << "\"";
 	}
 
+	// An id attribute known at compile time, e.g. Id<"main">
+	template <fixed_string Name>
+	class Id<Name> {
+	public:
+		using key = Id<>;
+		static constexpr auto text = fixed_string{ " id=\"" } + Name + fixed_string{ "\"" };
+
+		static constexpr std::string_view getName() {
+			return Name.view();
+		}
+
+		constexpr void writeStatic(StaticWriter& writer) const {
+			writer.write(text.view().substr(1));
+		}
+	};
+	template <fixed_string Name>
+	std::ostream& operator<<(std::ostream& stream, const Id<Name>& /*id*/) {
+		return stream.write(Id<Name>::text.data() + 1, Id<Name>::text.size() - 1);
+	}
+
+	// Attributes with a `text` member are fully known at compile time and
+	// can be folded into the opening tag of an element
+	template <typename T>
+	concept StaticAttribute = requires {
+		{ std::decay_t<T>::text.view() } -> std::convertible_to<std::string_view>;
+	};
+
+	// Attributes of the same kind (e.g. Class{"a"} and Class<"b">) share a key
+	template <typename T>
+	struct attribute_key {
+		using type = std::decay_t<T>;
+	};
+	template <typename T>
+		requires requires { typename std::decay_t<T>::key; }
+	struct attribute_key<T> {
+		using type = typename std::decay_t<T>::key;
+	};
+	template <typename T>
+	using attribute_key_t = typename attribute_key<T>::type;
+
+	// Attributes may write themselves, leading space included, with a
+	// writeAttribute member, e.g. to write nothing at all
+	template <typename T>
+	void WriteAttribute(std::ostream& stream, const T& attribute) {
+		if constexpr (StaticAttribute<T>) {
+			stream.write(T::text.data(), T::text.size());
+		}
+		else if constexpr (requires { attribute.writeAttribute(stream); }) {
+			attribute.writeAttribute(stream);
+		}
+		else {
+			stream << " " << attribute;
+		}
+	}
+
+	template <typename T>
+	constexpr void WriteStaticAttribute(StaticWriter& writer, const T& attribute) {
+		if constexpr (StaticAttribute<T>) {
+			writer.write(T::text.view());
+		}
+		else if constexpr (requires { attribute.writeStaticAttribute(writer); }) {
+			attribute.writeStaticAttribute(writer);
+		}
+		else {
+			writer.put(' ');
+			WriteStatic(writer, attribute);
+		}
+	}
+
 	template <typename... Args>
 	class Attr {
 
 		std::tuple<Args...> attributes;
 
 	public:
-		explicit Attr(Args&&... args) : 
-			attributes(std::make_tuple(std::forward<Args>(args)...))
+		constexpr explicit Attr(Args&&... args) :
+			attributes(std::forward<Args>(args)...)
 		{
-			static_assert(!contains_duplicates<Args...>::value, "Must not contain duplicates");
+			static_assert(!contains_duplicates<attribute_key_t<Args>...>::value, "Must not contain duplicates");
 		}
 
 		void print(std::ostream& stream) const {
 			std::apply([&stream](auto&&... args)
 			{
-				((stream << " " << args), ...);
+				(WriteAttribute(stream, args), ...);
+			}, attributes);
+		}
+
+		constexpr void writeStatic(StaticWriter& writer) const {
+			std::apply([&writer](const auto&... args)
+			{
+				(WriteStaticAttribute(writer, args), ...);
 			}, attributes);
 		}
 	};
@@ -69,96 +288,506 @@ namespace Web {
 	{
 		stream << data;
 	}
+	template <NumericValue T>
+	void WriteToStream(std::ostream& stream, const T& data)
+	{
+		WriteNumber(stream, data);
+	}
+	template <typename T>
+	void WriteToStream(std::ostream& stream, const std::vector<T>& data);
+	template <typename T>
+	void WriteToStream(std::ostream& stream, const Profiled<T>& profiled)
+	{
+#if WEB_PROFILE
+		const ProfileScope profile(profiled.getName(), stream);
+#endif
+		WriteToStream(stream, profiled.getChild());
+	}
 	template <typename T>
 	void WriteToStream(std::ostream& stream, const std::vector<T>& data) {
 		for(const auto& d : data) {
-			stream << d;
+			WriteToStream(stream, d);
 		}
 	}
 
+	// A type-erased view of a child, for renderers that walk the tree one node
+	// at a time rather than streaming it in a single call
+	struct NodeRef {
+		using WriteFunction = void(*)(std::ostream&, const void*);
+		using ChildFunction = std::optional<NodeRef>(*)(const void*, std::size_t);
+
+		const void* object;
+		// Everything before the children, or the whole value for a leaf
+		WriteFunction open;
+		// Everything after the children, or nullptr
+		WriteFunction close;
+		// Returns the child at an index, or nothing past the last one. Children
+		// must be requested in order from 0. nullptr for leaves.
+		ChildFunction child;
+	};
+
+	template <typename T>
+	NodeRef MakeNodeRef(const T& value) {
+		if constexpr (requires { { value.nodeRef() } -> std::same_as<NodeRef>; }) {
+			return value.nodeRef();
+		}
+		else {
+			return NodeRef{ &value, [](std::ostream& stream, const void* object) {
+				WriteToStream(stream, *static_cast<const T*>(object));
+			}, nullptr, nullptr };
+		}
+	}
+	template <typename T>
+	NodeRef MakeNodeRef(const std::vector<T>& data) {
+		return NodeRef{ &data, nullptr, nullptr, [](const void* object, std::size_t index) -> std::optional<NodeRef> {
+			const auto& items = *static_cast<const std::vector<T>*>(object);
+			if (index < items.size()) {
+				return MakeNodeRef(items[index]);
+			}
+			return std::nullopt;
+		} };
+	}
+	template <typename T>
+	NodeRef MakeNodeRef(const Profiled<T>& profiled) {
+		return NodeRef{ &profiled, nullptr, nullptr, [](const void* object, std::size_t index) -> std::optional<NodeRef> {
+			if (index == 0) {
+				return MakeNodeRef(static_cast<const Profiled<T>*>(object)->getChild());
+			}
+			return std::nullopt;
+		} };
+	}
+
+	namespace detail {
+		// A tuple whose element types are hidden from the object holding it,
+		// like a std::any that knows how to render its contents. Unlike
+		// std::any it works in constant evaluation, where it always allocates;
+		// at runtime tuples as small as a pointer are stored in place.
+		class ErasedTuple {
+			class Concept {
+			public:
+				constexpr virtual ~Concept() = default;
+				constexpr virtual Concept* clone() const = 0;
+				virtual Concept* cloneInto(void* buffer) const = 0;
+				virtual Concept* moveInto(void* buffer) noexcept = 0;
+				virtual void stream(std::ostream& stream) const = 0;
+				virtual std::optional<NodeRef> child(std::size_t index) const = 0;
+				constexpr virtual void writeStatic(StaticWriter& writer) const = 0;
+			};
+
+			template <typename Tuple>
+			class Model final : public Concept {
+				Tuple tuple;
+
+			public:
+				constexpr explicit Model(Tuple&& tuple) :
+					tuple(std::move(tuple))
+				{}
+				constexpr ~Model() override = default;
+
+				constexpr Concept* clone() const override {
+					return new Model(*this);
+				}
+				Concept* cloneInto(void* buffer) const override {
+					return ::new (buffer) Model(*this);
+				}
+				Concept* moveInto(void* buffer) noexcept override {
+					return ::new (buffer) Model(std::move(*this));
+				}
+
+				void stream(std::ostream& stream) const override {
+					std::apply([&stream](const auto&... item) { (WriteToStream(stream, item), ...); }, tuple);
+				}
+
+				std::optional<NodeRef> child([[maybe_unused]] std::size_t index) const override {
+					std::optional<NodeRef> result;
+					[&]<std::size_t... I>(std::index_sequence<I...>) {
+						((index == I ? void(result = MakeNodeRef(std::get<I>(tuple))) : void()), ...);
+					}(std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+					return result;
+				}
+
+				constexpr void writeStatic(StaticWriter& writer) const override {
+					std::apply([&writer](const auto&... item) { (WriteStatic(writer, item), ...); }, tuple);
+				}
+			};
+
+			static constexpr std::size_t bufferSize = 2 * sizeof(void*);
+
+			template <typename Tuple>
+			static constexpr bool storedInPlace = sizeof(Model<Tuple>) <= bufferSize
+				&& alignof(Model<Tuple>) <= alignof(void*)
+				&& std::is_nothrow_move_constructible_v<Tuple>;
+
+			Concept* object = nullptr;
+			bool inPlace = false;
+			alignas(void*) unsigned char buffer[bufferSize];
+
+			constexpr void reset() noexcept {
+				if (inPlace) {
+					object->~Concept();
+					inPlace = false;
+				}
+				else {
+					delete object;
+				}
+				object = nullptr;
+			}
+
+			constexpr void take(ErasedTuple& other) noexcept {
+				if (other.inPlace) {
+					object = other.object->moveInto(buffer);
+					inPlace = true;
+					other.reset();
+				}
+				else {
+					object = std::exchange(other.object, nullptr);
+				}
+			}
+
+		public:
+			constexpr ErasedTuple() noexcept = default;
+
+			template <typename... Ts>
+			constexpr explicit ErasedTuple(std::tuple<Ts...>&& tuple) {
+				using Stored = Model<std::tuple<Ts...>>;
+				if constexpr (storedInPlace<std::tuple<Ts...>>) {
+					if (!std::is_constant_evaluated()) {
+						object = ::new (static_cast<void*>(buffer)) Stored(std::move(tuple));
+						inPlace = true;
+						return;
+					}
+				}
+				object = new Stored(std::move(tuple));
+			}
+
+			constexpr ErasedTuple(const ErasedTuple& other) {
+				if (other.inPlace) {
+					object = other.object->cloneInto(buffer);
+					inPlace = true;
+				}
+				else if (other.object != nullptr) {
+					object = other.object->clone();
+				}
+			}
+			constexpr ErasedTuple(ErasedTuple&& other) noexcept {
+				take(other);
+			}
+			constexpr ErasedTuple& operator=(const ErasedTuple& other) {
+				if (this != &other) {
+					*this = ErasedTuple(other);
+				}
+				return *this;
+			}
+			constexpr ErasedTuple& operator=(ErasedTuple&& other) noexcept {
+				if (this != &other) {
+					reset();
+					take(other);
+				}
+				return *this;
+			}
+			constexpr ~ErasedTuple() {
+				reset();
+			}
+
+			constexpr bool hasValue() const {
+				return object != nullptr;
+			}
+
+			void stream(std::ostream& stream) const {
+				if (object != nullptr) {
+					object->stream(stream);
+				}
+			}
+			std::optional<NodeRef> child(std::size_t index) const {
+				if (object != nullptr) {
+					return object->child(index);
+				}
+				return std::nullopt;
+			}
+			constexpr void writeStatic(StaticWriter& writer) const {
+				if (object != nullptr) {
+					object->writeStatic(writer);
+				}
+			}
+		};
+	}
+
+	// The markup of a tag built at compile time. When every attribute is a
+	// StaticAttribute the whole opening tag, e.g. <div class="center">, is one literal.
+	template <typename T, typename... Attributes>
+	struct StaticTag {
+		static constexpr auto name = [] {
+			fixed_string<constexpr_strlen(T::tag) + 1> result;
+			for (std::size_t i = 0; i < result.size(); ++i) {
+				result.value[i] = T::tag[i];
+			}
+			return result;
+		}();
+
+		static constexpr auto start = fixed_string{ "<" } + name;
+		static constexpr auto open = (start + ... + Attributes::text) + fixed_string{ ">" };
+		static constexpr auto close = fixed_string{ "</" } + name + fixed_string{ ">" };
+	};
+
 	template <typename T>
 	class HtmlBase {
-		using AnyStreamFunctionPtr = std::ostream&(*)(std::ostream&, const std::any&);
+		// Empty for elements without children
+		detail::ErasedTuple children;
+
+		// The full opening tag, or only "<tag" when runtime attributes follow
+		std::string_view openTag;
+		// Empty when every attribute is folded into openTag
+		detail::ErasedTuple attributes;
 
-		AnyStreamFunctionPtr streamFunc;
-		std::any data;
+#if WEB_VALIDATE
+		// An Id<"..."> folded into openTag, still checked for uniqueness when rendering
+		std::string_view staticId;
 
-		std::optional<std::any> attributes;
-		AnyStreamFunctionPtr attrStreamFuncPtr;
+		template <typename... Attributes>
+		static constexpr std::string_view staticIdFor() {
+			std::string_view id;
+			([&id] {
+				if constexpr (StaticAttribute<Attributes> && std::is_same_v<attribute_key_t<Attributes>, Id<>>) {
+					id = Attributes::getName();
+				}
+			}(), ...);
+			return id;
+		}
+#endif
+
+		template <typename... Attributes>
+		static constexpr std::string_view openTagFor() {
+			if constexpr ((StaticAttribute<Attributes> && ...)) {
+				return StaticTag<T, Attributes...>::open.view();
+			}
+			else {
+				return StaticTag<T>::start.view();
+			}
+		}
+
+		template <typename... Args>
+		static constexpr detail::ErasedTuple storeChildren(Args&&... args) {
+			if constexpr (sizeof...(Args) == 0) {
+				return detail::ErasedTuple{};
+			}
+			else {
+				return detail::ErasedTuple{ std::make_tuple(std::forward<Args>(args)...) };
+			}
+		}
+
+		template <typename... Attributes>
+		static constexpr detail::ErasedTuple storeAttributes(Attr<Attributes...>&& attr) {
+			if constexpr ((StaticAttribute<Attributes> && ...)) {
+				return detail::ErasedTuple{};
+			}
+			else {
+				return detail::ErasedTuple{ std::make_tuple(std::move(attr)) };
+			}
+		}
+
+		template <typename... Args>
+		static constexpr bool checkChildren() {
+#if WEB_CONTENT_MODEL_VALIDATION
+			static_assert(!VoidElement<T> || sizeof...(Args) == 0, "Void elements cannot have children");
+			return (check_child<T, Args>::value && ...);
+#else
+			return true;
+#endif
+		}
 
 	public:
 
 		template <typename... Attributes, typename... Args>
-		HtmlBase(Attr<Attributes...>&& attr, Args&&... args) noexcept :
-			streamFunc(dataStreamFunc<Args...>()),
-			data(std::make_tuple(std::forward<Args>(args)...)),
-			attributes(std::make_tuple(std::forward<Attr<Attributes...>>(attr))),
-			attrStreamFuncPtr(dataStreamFunc<Attr<Attributes...>>())
+		constexpr HtmlBase(Attr<Attributes...>&& attr, Args&&... args) :
+			children(storeChildren(std::forward<Args>(args)...)),
+			openTag(openTagFor<Attributes...>()),
+			attributes(storeAttributes(std::move(attr)))
+#if WEB_VALIDATE
+			, staticId(staticIdFor<Attributes...>())
+#endif
 		{
+			static_assert(checkChildren<Args...>());
 		}
 
 		template <typename... Args>
-		HtmlBase(Args&&... args) noexcept :
-			streamFunc(dataStreamFunc<Args...>()),
-			data(std::make_tuple(std::forward<Args>(args)...))
-		{}
+		constexpr HtmlBase(Args&&... args) :
+			children(storeChildren(std::forward<Args>(args)...)),
+			openTag(StaticTag<T>::open.view())
+		{
+			static_assert(checkChildren<Args...>());
+		}
 
-		std::ostream& streamOut(std::ostream& str) const {
-			str << "<" << T::tag;
-			if (attributes)
+		std::ostream& streamOut(std::ostream& str) const;
+
+		void streamOpen(std::ostream& str) const {
+			str.write(openTag.data(), openTag.size());
+			if (attributes.hasValue())
 			{
-				attrStreamFuncPtr(str, *attributes);
+				attributes.stream(str);
+				str.put('>');
 			}
-			str << ">";
-			streamFunc(str, data);
-			str << "</" << T::tag << ">";
-			return str;
 		}
 
-		template <typename... Args>
-		AnyStreamFunctionPtr dataStreamFunc() const {
-			using AnyType = std::tuple<std::decay_t<Args>...>;
+		void streamClose(std::ostream& str) const {
+			if constexpr (!VoidElement<T>) {
+				constexpr auto close = StaticTag<T>::close.view();
+				str.write(close.data(), close.size());
+			}
+		}
 
-			return [](std::ostream& stream, const std::any& data) -> std::ostream& {
-				try {
-					const AnyType& children = std::any_cast<const AnyType&>(data);
-					std::apply([&stream](const auto&... item) { (WriteToStream(stream, item), ...); }, children);
-				}
-				catch (std::bad_any_cast& /*e*/) {
-					assert(false); // The types have not worked if we are here
-				}
-				return stream;
-			};
+		NodeRef nodeRef() const;
+
+		constexpr void writeStatic(StaticWriter& writer) const {
+			writer.write(openTag);
+			if (attributes.hasValue()) {
+				attributes.writeStatic(writer);
+				writer.put('>');
+			}
+			children.writeStatic(writer);
+			if constexpr (!VoidElement<T>) {
+				writer.write(StaticTag<T>::close.view());
+			}
 		}
 	};
 
+	// Defined outside the class, so not inline, so that extern template
+	// declarations below keep them out of every translation unit
+	template <typename T>
+	std::ostream& HtmlBase<T>::streamOut(std::ostream& str) const {
+#if WEB_VALIDATE
+		const ValidationScope validation(StaticTag<T>::name.view(),
+			content_categories_v<T>, permitted_content_v<T>, forbidden_content_v<T>);
+		if (!staticId.empty()) {
+			ValidateId(staticId);
+		}
+#endif
+#if WEB_PROFILE
+		const ProfileScope profile(StaticTag<T>::name.view(), str);
+#endif
+		streamOpen(str);
+		children.stream(str);
+		streamClose(str);
+		return str;
+	}
+
+	template <typename T>
+	NodeRef HtmlBase<T>::nodeRef() const {
+		return NodeRef{
+			this,
+			[](std::ostream& stream, const void* object) { static_cast<const HtmlBase*>(object)->streamOpen(stream); },
+			[](std::ostream& stream, const void* object) { static_cast<const HtmlBase*>(object)->streamClose(stream); },
+			[](const void* object, std::size_t index) {
+				const auto* self = static_cast<const HtmlBase*>(object);
+				return self->children.child(index);
+			}
+		};
+	}
+
 	template <typename T>
 	std::ostream& operator<<(std::ostream& str, const HtmlBase<T>& base) {
 		return base.streamOut(str);
 	}
 
+// An element that accepts any children and may appear anywhere
 #define WEB_HTML_TAG_NO_VALIDATION(NAME, TAG) 		\
-class NAME : public HtmlBase<NAME> {				\
+class NAME : public Web::HtmlBase<NAME> {				\
 public:												\
 	static constexpr const char* tag = TAG;	\
+	static constexpr Web::ContentCategories categories = Web::Content::Any;			\
+	static constexpr Web::ContentCategories permittedContent = Web::Content::Any;	\
 	template <typename... Args>						\
-	explicit NAME(Args&&... args) noexcept :		\
-		HtmlBase<NAME>(std::forward<Args>(args)...)	\
+	constexpr explicit NAME(Args&&... args) :		\
+		Web::HtmlBase<NAME>(std::forward<Args>(args)...)	\
 	{}												\
 };
 
-	WEB_HTML_TAG_NO_VALIDATION(H2, "h2");
-	WEB_HTML_TAG_NO_VALIDATION(P, "p");
-	WEB_HTML_TAG_NO_VALIDATION(H1, "h1");
-	WEB_HTML_TAG_NO_VALIDATION(Div, "div");
-	WEB_HTML_TAG_NO_VALIDATION(Body, "body");
+// An element checked against the content model: CATEGORIES are the content
+// categories it belongs to and PERMITTED the categories its children may have
+#define WEB_HTML_TAG(NAME, TAG, CATEGORIES, PERMITTED)	\
+class NAME : public Web::HtmlBase<NAME> {				\
+public:												\
+	static constexpr const char* tag = TAG;	\
+	static constexpr Web::ContentCategories categories = CATEGORIES;			\
+	static constexpr Web::ContentCategories permittedContent = PERMITTED;		\
+	template <typename... Args>						\
+	constexpr explicit NAME(Args&&... args) :		\
+		Web::HtmlBase<NAME>(std::forward<Args>(args)...)	\
+	{}												\
+};
+
+// An element with no children or closing tag, e.g. <img>
+#define WEB_HTML_VOID_TAG(NAME, TAG, CATEGORIES)	\
+class NAME : public Web::HtmlBase<NAME> {				\
+public:												\
+	static constexpr const char* tag = TAG;	\
+	static constexpr bool isVoid = true;			\
+	static constexpr Web::ContentCategories categories = CATEGORIES;			\
+	static constexpr Web::ContentCategories permittedContent = Web::Content::None;	\
+	template <typename... Args>						\
+	constexpr explicit NAME(Args&&... args) :		\
+		Web::HtmlBase<NAME>(std::forward<Args>(args)...)	\
+	{}												\
+};
+
+	WEB_HTML_TAG(Head, "head", Content::Head, Content::Metadata);
+	WEB_HTML_TAG(Title, "title", Content::Metadata, Content::Text);
+	WEB_HTML_VOID_TAG(Meta, "meta", Content::Metadata);
+	WEB_HTML_VOID_TAG(Link, "link", Content::Metadata);
+	WEB_HTML_TAG(Body, "body", Content::Body, Content::Flow);
+
+	WEB_HTML_TAG(H1, "h1", Content::Flow | Content::Heading, Content::Phrasing);
+	WEB_HTML_TAG(H2, "h2", Content::Flow | Content::Heading, Content::Phrasing);
+	WEB_HTML_TAG(H3, "h3", Content::Flow | Content::Heading, Content::Phrasing);
+	WEB_HTML_TAG(P, "p", Content::Flow, Content::Phrasing);
+	WEB_HTML_TAG(Div, "div", Content::Flow, Content::Flow);
+	WEB_HTML_TAG(Main, "main", Content::Flow, Content::Flow);
+	WEB_HTML_TAG(Header, "header", Content::Flow, Content::Flow);
+	WEB_HTML_TAG(Footer, "footer", Content::Flow, Content::Flow);
+	WEB_HTML_TAG(Section, "section", Content::Flow | Content::Sectioning, Content::Flow);
+	WEB_HTML_TAG(Article, "article", Content::Flow | Content::Sectioning, Content::Flow);
+	WEB_HTML_TAG(Nav, "nav", Content::Flow | Content::Sectioning, Content::Flow);
+	WEB_HTML_VOID_TAG(Hr, "hr", Content::Flow);
+
+	WEB_HTML_TAG(Ul, "ul", Content::Flow, Content::ListItem);
+	WEB_HTML_TAG(Ol, "ol", Content::Flow, Content::ListItem);
+	WEB_HTML_TAG(Li, "li", Content::ListItem, Content::Flow);
+
+	WEB_HTML_TAG(Table, "table", Content::Flow, Content::Caption | Content::TableSection | Content::TableRow);
+	WEB_HTML_TAG(Caption, "caption", Content::Caption, Content::Flow);
+	WEB_HTML_TAG(Thead, "thead", Content::TableSection, Content::TableRow);
+	WEB_HTML_TAG(Tbody, "tbody", Content::TableSection, Content::TableRow);
+	WEB_HTML_TAG(Tfoot, "tfoot", Content::TableSection, Content::TableRow);
+	WEB_HTML_TAG(Tr, "tr", Content::TableRow, Content::TableCell);
+	WEB_HTML_TAG(Th, "th", Content::TableCell, Content::Flow);
+	WEB_HTML_TAG(Td, "td", Content::TableCell, Content::Flow);
+
+	WEB_HTML_TAG(Span, "span", Content::Flow | Content::Phrasing, Content::Phrasing);
+	WEB_HTML_TAG(Strong, "strong", Content::Flow | Content::Phrasing, Content::Phrasing);
+	WEB_HTML_TAG(Em, "em", Content::Flow | Content::Phrasing, Content::Phrasing);
+	WEB_HTML_VOID_TAG(Img, "img", Content::Flow | Content::Phrasing | Content::Embedded);
+
+	// <a> is transparent, so it permits flow content but never other interactive content
+	class A : public HtmlBase<A> {
+	public:
+		static constexpr const char* tag = "a";
+		static constexpr ContentCategories categories = Content::Flow | Content::Phrasing | Content::Interactive;
+		static constexpr ContentCategories permittedContent = Content::Flow;
+		static constexpr ContentCategories forbiddenContent = Content::Interactive;
+
+		template <typename... Args>
+		constexpr explicit A(Args&&... args) :
+			HtmlBase<A>(std::forward<Args>(args)...)
+		{}
+	};
 
 	class Html : public HtmlBase<Html> {
 	public:
 		static constexpr const char* tag = "html";
+		static constexpr ContentCategories categories = Content::None;
+		static constexpr ContentCategories permittedContent = Content::Head | Content::Body;
 		
 		template <typename... Args>
-		explicit Html(Args&&... args) noexcept :
+		constexpr explicit Html(Args&&... args) :
 			HtmlBase<Html>(std::forward<Args>(args)...)
 		{
 			static_assert((0 + ... + (std::is_same_v<std::decay_t<Args>, Body> ? 1 : 0)) == 1, 
@@ -166,8 +795,77 @@ public:												\
 		}
 	};
 
-	class Br {};
-	inline std::ostream& operator<<(std::ostream& stream, const Br& /*br*/) {
-		return stream << "<br/>";
+	class Br {
+	public:
+		static constexpr ContentCategories categories = Content::Flow | Content::Phrasing;
+
+		constexpr void writeStatic(StaticWriter& writer) const {
+			writer.write("<br/>");
+		}
+	};
+	std::ostream& operator<<(std::ostream& stream, const Br& br);
+
+	// Markup rendered at compile time, see renderStatic
+	template <std::size_t N>
+	struct StaticHtml {
+		std::array<char, N> bytes{};
+
+		constexpr std::string_view view() const {
+			return std::string_view(bytes.data(), N);
+		}
+	};
+	template <std::size_t N>
+	std::ostream& operator<<(std::ostream& stream, const StaticHtml<N>& html) {
+		return stream.write(html.bytes.data(), N);
+	}
+
+	// Renders a tree at compile time. The tree is returned by a lambda without
+	// captures, as the tree itself can't be a constant:
+	//
+	//   constexpr auto page = Web::renderStatic([] {
+	//       return Web::Html{ Web::Body{ Web::H1{ "Hello" } } };
+	//   });
+	//   stream << page; // a single write
+	//
+	// Trees with children that can only be rendered at runtime, such as
+	// floating point numbers or components, fail to compile. Runtime
+	// validation such as unique ids is not applied.
+	template <typename Build>
+	consteval auto renderStatic(Build) {
+		static_assert(std::is_empty_v<Build> && std::is_default_constructible_v<Build>,
+			"renderStatic needs a lambda without captures that returns the tree");
+
+		constexpr std::size_t size = [] {
+			StaticWriter writer;
+			WriteStatic(writer, Build{}());
+			return writer.take().size();
+		}();
+
+		StaticWriter writer;
+		WriteStatic(writer, Build{}());
+		const std::string text = writer.take();
+		StaticHtml<size> html;
+		for (std::size_t i = 0; i < size; ++i) {
+			html.bytes[i] = text[i];
+		}
+		return html;
 	}
+
+// The elements whose non-template members the web library compiles once, in
+// src/elements.cpp
+#define WEB_COMMON_ELEMENTS(X)																\
+	X(Html) X(Head) X(Title) X(Meta) X(Link) X(Body) X(H1) X(H2) X(H3) X(P) X(Div) X(Main)	\
+	X(Header) X(Footer) X(Section) X(Article) X(Nav) X(Ul) X(Ol) X(Li) X(Table) X(Thead)	\
+	X(Tbody) X(Tr) X(Th) X(Td) X(Span) X(Strong) X(Em) X(A) X(Img)
+
+// Those members depend on WEB_VALIDATE and WEB_PROFILE, so only translation
+// units built with the library's settings may use the library's copies
+#if defined(WEB_LIBRARY_VALIDATE) && WEB_VALIDATE == WEB_LIBRARY_VALIDATE && WEB_PROFILE == WEB_LIBRARY_PROFILE
+#define WEB_EXTERN_ELEMENTS 1
+#define WEB_EXTERN_ELEMENT(NAME) extern template class HtmlBase<NAME>;
+	WEB_COMMON_ELEMENTS(WEB_EXTERN_ELEMENT)
+#undef WEB_EXTERN_ELEMENT
+#else
+#define WEB_EXTERN_ELEMENTS 0
+#endif
 }
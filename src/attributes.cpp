@@ -0,0 +1,97 @@
+#include <attributes.hpp>
+
+namespace Web {
+
+	Url::Url(std::string_view url) {
+		constexpr char hex[] = "0123456789ABCDEF";
+		encoded.reserve(url.size());
+		for (const char c : url) {
+			if (detail::urlNeedsEncoding(c)) {
+				const auto byte = static_cast<unsigned char>(c);
+				encoded += '%';
+				encoded += hex[byte >> 4];
+				encoded += hex[byte & 0xf];
+			}
+			else {
+				encoded += c;
+			}
+		}
+	}
+
+	AttributeSet::AddResult AttributeSet::insert(std::string_view name, AttributeType type, std::string value, bool written) {
+		const std::optional<std::size_t> index = findStandardAttribute(name);
+		if (index) {
+			const AttributeType expected = standardAttributes[*index].type;
+			// Numbers are also accepted as text
+			if (type != expected && !(type == AttributeType::Number && expected == AttributeType::Text)) {
+				return AddResult::Invalid;
+			}
+			std::uint64_t& word = present[*index / 64];
+			const std::uint64_t bit = std::uint64_t{ 1 } << (*index % 64);
+			if ((word & bit) != 0) {
+				return AddResult::Duplicate;
+			}
+			word |= bit;
+			if (written) {
+				entries.push_back(Entry{ static_cast<std::uint16_t>(*index), std::string(), std::move(value) });
+			}
+			return AddResult::Inserted;
+		}
+
+		// Custom attributes are data-* and take text or numbers
+		if (!isDataAttributeName(name) || (type != AttributeType::Text && type != AttributeType::Number)) {
+			return AddResult::Invalid;
+		}
+		if (contains(name)) {
+			return AddResult::Duplicate;
+		}
+		entries.push_back(Entry{ customName, std::string(name), std::move(value) });
+		return AddResult::Inserted;
+	}
+
+	AttributeSet::AddResult AttributeSet::add(std::string_view name, std::string_view text) {
+		std::string value(text);
+		detail::escapeAttributeValue(value);
+		return insert(name, AttributeType::Text, std::move(value));
+	}
+
+	AttributeSet::AddResult AttributeSet::add(std::string_view name, bool present) {
+		// An absent boolean attribute writes nothing but still takes the name
+		return insert(name, AttributeType::Boolean, std::string(), present);
+	}
+
+	AttributeSet::AddResult AttributeSet::add(std::string_view name, const Url& url) {
+		return insert(name, AttributeType::Url, url.view());
+	}
+
+	bool AttributeSet::contains(std::string_view name) const {
+		if (const std::optional<std::size_t> index = findStandardAttribute(name)) {
+			return (present[*index / 64] & (std::uint64_t{ 1 } << (*index % 64))) != 0;
+		}
+		for (const Entry& entry : entries) {
+			if (entry.index == customName && entry.name == name) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void AttributeSet::writeAttribute(std::ostream& stream) const {
+		for (const Entry& entry : entries) {
+			if (entry.index != customName) {
+				const std::string_view prefix = standardAttributePrefix(entry.index);
+				stream.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+				if (standardAttributes[entry.index].type == AttributeType::Boolean) {
+					continue;
+				}
+			}
+			else {
+				stream.put(' ');
+				stream.write(entry.name.data(), static_cast<std::streamsize>(entry.name.size()));
+				stream.write("=\"", 2);
+			}
+			stream.write(entry.value.data(), static_cast<std::streamsize>(entry.value.size()));
+			stream.put('"');
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#include <class-list.hpp>
+#include <cassert>
+
+namespace Web::detail {
+
+	bool ClassListSet::containsAdded(std::string_view name, std::uint32_t hash) const {
+		for (std::size_t i = 0; i < count; ++i) {
+			const Entry& existing = entry(i);
+			if (existing.hash == hash && nameOf(existing) == name) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ClassListSet::contains(std::string_view name) const {
+		const std::uint32_t hash = hashClassName(name);
+		for (std::size_t i = 0; i < staticCount; ++i) {
+			if (staticHashes[i] == hash && staticNames[i] == name) {
+				return true;
+			}
+		}
+		return containsAdded(name, hash);
+	}
+
+	void ClassListSet::push(const Entry& entry) {
+		if (count < inlineCapacity) {
+			inlineEntries[count] = entry;
+		}
+		else {
+			moreEntries.push_back(entry);
+		}
+		++count;
+	}
+
+	void ClassListSet::add(std::string_view classes) {
+		ValidateAttributeValue(classes);
+		std::size_t position = 0;
+		while (position < classes.size()) {
+			if (isClassSpace(classes[position])) {
+				++position;
+				continue;
+			}
+			std::size_t end = position;
+			while (end < classes.size() && !isClassSpace(classes[end])) {
+				++end;
+			}
+			const std::string_view name = classes.substr(position, end - position);
+			if (!contains(name)) {
+				push(Entry{ nullptr, static_cast<std::uint32_t>(text.size()), static_cast<std::uint32_t>(name.size()), hashClassName(name) });
+				text.append(name);
+			}
+			position = end;
+		}
+	}
+
+	void ClassListSet::addStatic(std::string_view name, std::uint32_t hash) {
+		assert(isClassName(name));
+		if (!containsAdded(name, hash)) {
+			push(Entry{ name.data(), 0, static_cast<std::uint32_t>(name.size()), hash });
+		}
+	}
+
+	void ClassListSet::write(std::ostream& stream, std::string_view prefix, bool leadingSpace) const {
+		// Write straight to the stream buffer, skipping the sentry per write
+		const std::ostream::sentry sentry(stream);
+		if (!sentry) {
+			return;
+		}
+		std::streambuf& buffer = *stream.rdbuf();
+		bool failed = buffer.sputn(prefix.data(), static_cast<std::streamsize>(prefix.size())) != static_cast<std::streamsize>(prefix.size());
+		for (std::size_t i = 0; i < count; ++i) {
+			if (leadingSpace || i != 0) {
+				failed |= buffer.sputc(' ') == std::char_traits<char>::eof();
+			}
+			const std::string_view name = nameOf(entry(i));
+			failed |= buffer.sputn(name.data(), static_cast<std::streamsize>(name.size())) != static_cast<std::streamsize>(name.size());
+		}
+		failed |= buffer.sputc('"') == std::char_traits<char>::eof();
+		if (failed) {
+			stream.setstate(std::ios_base::badbit);
+		}
+	}
+}
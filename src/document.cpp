@@ -0,0 +1,208 @@
+#include <document.hpp>
+#include <memory>
+#include <new>
+
+namespace Web {
+
+	std::ostream& Document::streamOut(std::ostream& stream) const {
+		// Write straight to the stream buffer, skipping the sentry per write
+		const std::ostream::sentry sentry(stream);
+		if (!sentry) {
+			return stream;
+		}
+		std::streambuf& buffer = *stream.rdbuf();
+		bool failed = false;
+		auto write = [&buffer, &failed](const char* data, std::streamsize size) {
+			failed |= buffer.sputn(data, size) != size;
+		};
+
+		// Only unusually deep documents need a stack from the heap. Failing to
+		// allocate it fails the stream rather than throwing.
+		Frame inlineStack[inlineStackDepth];
+		std::unique_ptr<Frame[]> heapStack;
+		Frame* stack = inlineStack;
+		if (maxDepth + 1 > inlineStackDepth) {
+			heapStack.reset(new (std::nothrow) Frame[maxDepth + 1]);
+			if (!heapStack) {
+				stream.setstate(std::ios_base::badbit);
+				return stream;
+			}
+			stack = heapStack.get();
+		}
+		for (std::uint32_t root = 0; root < rootCount; ++root) {
+			writeSubtree(childIndices[rootFirst + root], stack, write);
+		}
+
+		if (failed) {
+			stream.setstate(std::ios_base::badbit);
+		}
+		return stream;
+	}
+
+	std::ostream& operator<<(std::ostream& stream, const Document& document) {
+		return document.streamOut(stream);
+	}
+
+	std::uint64_t DocumentBuilder::mix(std::uint64_t seed, std::uint64_t value) {
+		return (seed ^ value) * 1099511628211ull + (seed >> 29);
+	}
+
+	std::uint64_t DocumentBuilder::hashContent(Document::NodeIndex index) const {
+		const Document::Node& node = document.nodes[index];
+		std::uint64_t hash = mix(static_cast<std::uint64_t>(node.kind), detail::fnv1a(document.getText(node.text)));
+		for (std::uint32_t a = 0; a < node.attributeCount; ++a) {
+			const Document::Attribute& attribute = document.attributes[node.firstAttribute + a];
+			hash = mix(mix(hash, detail::fnv1a(document.getText(attribute.name))), detail::fnv1a(document.getText(attribute.value)));
+		}
+		return hash;
+	}
+
+	std::uint64_t DocumentBuilder::hashNode(Document::NodeIndex index) const {
+		return document.nodes[index].kind == Document::NodeKind::Element ? hashes[index] : hashContent(index);
+	}
+
+	bool DocumentBuilder::equalNodes(Document::NodeIndex a, Document::NodeIndex b) const {
+		const Document::Node& left = document.nodes[a];
+		const Document::Node& right = document.nodes[b];
+		if (left.kind != right.kind || left.attributeCount != right.attributeCount || left.childCount != right.childCount
+			|| document.getText(left.text) != document.getText(right.text)) {
+			return false;
+		}
+		for (std::uint32_t i = 0; i < left.attributeCount; ++i) {
+			const Document::Attribute& l = document.attributes[left.firstAttribute + i];
+			const Document::Attribute& r = document.attributes[right.firstAttribute + i];
+			if (document.getText(l.name) != document.getText(r.name) || document.getText(l.value) != document.getText(r.value)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool DocumentBuilder::equalSubtrees(Document::NodeIndex a, Document::NodeIndex b) const {
+		std::vector<std::pair<Document::NodeIndex, Document::NodeIndex>> stack{ { a, b } };
+		while (!stack.empty()) {
+			const auto [left, right] = stack.back();
+			stack.pop_back();
+			if (left == right) {
+				continue;
+			}
+			if (!equalNodes(left, right)) {
+				return false;
+			}
+			const Document::Node& node = document.nodes[left];
+			for (std::uint32_t i = 0; i < node.childCount; ++i) {
+				stack.emplace_back(document.childIndices[node.firstChild + i],
+					document.childIndices[document.nodes[right].firstChild + i]);
+			}
+		}
+		return true;
+	}
+
+	Document::NodeIndex DocumentBuilder::deduplicate(const OpenElement& element) {
+		const Document::NodeIndex index = element.node;
+		const Document::Node& node = document.nodes[index];
+		std::uint64_t hash = hashContent(index);
+		for (std::uint32_t i = 0; i < node.childCount; ++i) {
+			hash = mix(hash, hashNode(document.childIndices[node.firstChild + i]));
+		}
+		hash = mix(hash, node.childCount);
+		hashes.resize(document.nodes.size());
+		reuses.resize(document.nodes.size());
+		hashes[index] = hash;
+
+		const auto [first, last] = subtreesByHash.equal_range(hash);
+		for (auto it = first; it != last; ++it) {
+			if (equalSubtrees(it->second, index)) {
+				const Document::NodeIndex existing = it->second;
+				truncate(index, element);
+				++reuses[existing];
+				++reusedSubtrees;
+				return existing;
+			}
+		}
+		subtrees.push_back(Subtree{ hash, index });
+		subtreesByHash.emplace(hash, index);
+		return index;
+	}
+
+	void DocumentBuilder::truncate(Document::NodeIndex index, const OpenElement& element) {
+		removedNodes += document.nodes.size() - index;
+		document.attributes.resize(document.nodes[index].firstAttribute);
+		document.nodes.resize(index);
+		document.childIndices.resize(element.childIndexMark);
+		document.textPool.resize(element.textMark);
+		tags.resize(element.tagMark);
+		hashes.resize(index);
+		reuses.resize(index);
+		while (!subtrees.empty() && subtrees.back().node >= index) {
+			const auto [first, last] = subtreesByHash.equal_range(subtrees.back().hash);
+			for (auto it = first; it != last; ++it) {
+				if (it->second == subtrees.back().node) {
+					subtreesByHash.erase(it);
+					break;
+				}
+			}
+			subtrees.pop_back();
+		}
+	}
+
+	void DocumentBuilder::cacheSharedSubtrees() {
+		document.cachedBytes.assign(document.nodes.size(), Document::TextRange{});
+		std::vector<Document::Frame> stack(document.maxDepth + 1);
+		std::string rendered;
+		auto write = [&rendered](const char* data, std::streamsize size) {
+			rendered.append(data, static_cast<std::size_t>(size));
+		};
+
+		// Walk down from the roots and cache the first shared subtree on each
+		// path. Shared subtrees inside it are written as part of its bytes, so
+		// caching them too would only store their bytes twice. Nodes that are
+		// not shared have one parent, so each is visited once.
+		std::vector<Document::NodeIndex> pendingNodes(
+			document.childIndices.begin() + document.rootFirst,
+			document.childIndices.begin() + document.rootFirst + document.rootCount);
+		while (!pendingNodes.empty()) {
+			const Document::NodeIndex index = pendingNodes.back();
+			pendingNodes.pop_back();
+			if (index < reuses.size() && reuses[index] != 0) {
+				if (document.cachedBytes[index].length == 0) {
+					rendered.clear();
+					document.writeSubtree(index, stack.data(), write);
+					document.cachedBytes[index] = appendText(rendered);
+				}
+				continue;
+			}
+			const Document::Node& node = document.nodes[index];
+			pendingNodes.insert(pendingNodes.end(),
+				document.childIndices.begin() + node.firstChild,
+				document.childIndices.begin() + node.firstChild + node.childCount);
+		}
+	}
+
+	Document DocumentBuilder::finish(BuildError* error) {
+		if (!openElements.empty()) {
+			fail(BuildError::Code::UnclosedElement);
+			while (!openElements.empty()) {
+				close();
+			}
+		}
+		if (error) {
+			*error = firstError;
+		}
+		document.rootFirst = static_cast<std::uint32_t>(document.childIndices.size());
+		document.rootCount = static_cast<std::uint32_t>(pending.size());
+		document.childIndices.insert(document.childIndices.end(), pending.begin(), pending.end());
+		if (options.cacheSharedSubtrees) {
+			cacheSharedSubtrees();
+		}
+		pending.clear();
+		tags.clear();
+		attributeTarget.reset();
+		hashes.clear();
+		reuses.clear();
+		subtrees.clear();
+		subtreesByHash.clear();
+		firstError = BuildError{};
+		return std::exchange(document, Document{});
+	}
+}
@@ -0,0 +1,12 @@
+// Only the element instantiations live here, so that a program built with
+// other validation or profiling settings never links this object
+#include <web.hpp>
+
+static_assert(WEB_EXTERN_ELEMENTS, "The web library must be built with WEB_LIBRARY_VALIDATE and WEB_LIBRARY_PROFILE set to its WEB_VALIDATE and WEB_PROFILE");
+
+namespace Web {
+
+#define WEB_INSTANTIATE_ELEMENT(NAME) template class HtmlBase<NAME>;
+	WEB_COMMON_ELEMENTS(WEB_INSTANTIATE_ELEMENT)
+#undef WEB_INSTANTIATE_ELEMENT
+}
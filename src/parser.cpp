@@ -0,0 +1,60 @@
+#include <parser.hpp>
+
+namespace Web {
+
+	template ParseError tokenizeHtml(std::string_view html, NullHtmlHandler& handler);
+	template ParseError tokenizeHtml(std::string_view html, DocumentHtmlHandler& handler);
+
+	ParseError validateHtml(std::string_view html) {
+		NullHtmlHandler handler;
+		return tokenizeHtml(html, handler);
+	}
+
+	void DocumentHtmlHandler::attribute(std::string_view name, std::string_view value) {
+		// Documents always quote with '"', so single quoted values may need escaping
+		if (value.find('"') == std::string_view::npos) {
+			builder.attribute(name, value);
+			return;
+		}
+		std::string escaped;
+		for (char c : value) {
+			if (c == '"') {
+				escaped += "&quot;";
+			}
+			else {
+				escaped += c;
+			}
+		}
+		builder.attribute(name, escaped);
+	}
+
+	std::optional<Document> parseHtml(std::string_view html, ParseError* error) {
+		DocumentBuilder builder;
+		// Rough upper bounds from the input size avoid regrowing the tables
+		builder.reserve(html.size() / 16 + 1, html.size() / 32 + 1, html.size());
+		DocumentHtmlHandler handler(builder);
+		const ParseError result = tokenizeHtml(html, handler);
+		if (error) {
+			*error = result;
+		}
+		if (result) {
+			return std::nullopt;
+		}
+		return builder.finish();
+	}
+
+	std::optional<RawHtml> RawHtml::create(std::string html, ParseError* error) {
+		const ParseError result = validateHtml(html);
+		if (error) {
+			*error = result;
+		}
+		if (result) {
+			return std::nullopt;
+		}
+		return RawHtml(std::move(html));
+	}
+
+	std::ostream& operator<<(std::ostream& stream, const RawHtml& raw) {
+		return stream.write(raw.getHtml().data(), static_cast<std::streamsize>(raw.getHtml().size()));
+	}
+}
@@ -0,0 +1,29 @@
+#include <validation.hpp>
+#include <iostream>
+
+namespace Web {
+
+	namespace detail {
+		void defaultValidationHandler(const ValidationError& error) {
+			static constexpr const char* descriptions[] = {
+				"duplicate id", "element not allowed here", "invalid attribute value"
+			};
+			std::cerr << "web-cpp validation: " << descriptions[static_cast<int>(error.code)]
+				<< " '" << error.subject << "'\n";
+			assert(false); // The rendered document is not valid HTML
+		}
+
+		std::atomic<ValidationHandler>& validationHandler() {
+			static std::atomic<ValidationHandler> handler{ defaultValidationHandler };
+			return handler;
+		}
+
+		void reportValidationError(ValidationError::Code code, std::string_view subject) {
+			validationHandler().load(std::memory_order_relaxed)(ValidationError{ code, subject });
+		}
+	}
+
+	ValidationHandler setValidationHandler(ValidationHandler handler) {
+		return detail::validationHandler().exchange(handler);
+	}
+}
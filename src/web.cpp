@@ -0,0 +1,8 @@
+#include <web.hpp>
+
+namespace Web {
+
+	std::ostream& operator<<(std::ostream& stream, const Br& /*br*/) {
+		return stream << "<br/>";
+	}
+}
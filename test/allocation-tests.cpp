@@ -0,0 +1,121 @@
+#include "catch.hpp"
+#include "support/allocation-counter.hpp"
+#include <web.hpp>
+#include <render.hpp>
+#include <document.hpp>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+Web::Div createNameList(const std::vector<std::string>& names) {
+	std::vector<Web::P> paragraphs;
+	std::transform(names.begin(), names.end(), std::back_inserter(paragraphs),
+		[](const std::string& name) { return Web::P{ name }; });
+	return Web::Div{ std::move(paragraphs) };
+}
+}
+
+TEST_CASE("The allocation counter sees operator new")
+{
+	// Kept past the test so optimised builds cannot elide the allocations
+	static std::unique_ptr<int> pointer;
+	static std::vector<int> numbers;
+	REQUIRE(WEB_ALLOCATIONS_IN(pointer = std::make_unique<int>(1)) == 1u);
+	REQUIRE(WEB_ALLOCATIONS_IN(numbers = std::vector<int>(16)) == 1u);
+	REQUIRE_NO_ALLOCATIONS(std::string("short"));
+}
+
+TEST_CASE("render appends to a string")
+{
+	std::string out = "<!DOCTYPE html>";
+	Web::render(out, Web::P{ "hello" });
+	REQUIRE(out == "<!DOCTYPE html><p>hello</p>");
+}
+
+TEST_CASE("render grows the string when it runs out of capacity")
+{
+	std::string out;
+	const std::string text(1000, 'x');
+	Web::render(out, Web::Div{ Web::P{ text }, Web::P{ text } });
+	REQUIRE(out == "<div><p>" + text + "</p><p>" + text + "</p></div>");
+}
+
+TEST_CASE("Rendering the example documents does not allocate")
+{
+	std::string out;
+	out.reserve(4096);
+
+	const auto para = Web::P{ "hello" };
+	REQUIRE_NO_ALLOCATIONS(Web::render(out, para));
+
+	const auto div = Web::Div{
+		Web::P { "Hello World" }
+	};
+	REQUIRE_NO_ALLOCATIONS(Web::render(out, div));
+
+	const auto doc = Web::Html{
+		Web::Body {
+			Web::H1{ "This is our title" },
+			Web::Br{},
+			Web::P { "Hello World" },
+			createNameList({ "John", "Jane", "Eric" })
+		}
+	};
+	REQUIRE_NO_ALLOCATIONS(Web::render(out, doc));
+
+	const auto attributes = Web::Div{
+		Web::Attr {
+			Web::Class{ "center" },
+			Web::Id{ "single" }
+		}
+	};
+	REQUIRE_NO_ALLOCATIONS(Web::render(out, attributes));
+
+	const auto centered = Web::Div{
+		Web::Attr {
+			Web::Class<"center">{},
+			Web::Id<"main">{}
+		},
+		Web::P{ "Centered" },
+		Web::P{ 42 },
+		Web::P{ 3.25 }
+	};
+	REQUIRE_NO_ALLOCATIONS(Web::render(out, centered));
+
+	REQUIRE(out.capacity() == 4096u);
+}
+
+TEST_CASE("Rendering into a FixedBuffer does not allocate")
+{
+	const auto doc = Web::Html{
+		Web::Body {
+			Web::H1{ "This is our title" },
+			createNameList({ "John", "Jane", "Eric" })
+		}
+	};
+	char storage[256];
+	Web::FixedBuffer sink(storage, sizeof(storage));
+	Web::RenderError error;
+	REQUIRE_NO_ALLOCATIONS(error = Web::render(sink, doc));
+	REQUIRE(!error);
+	REQUIRE(sink.view() == "<html><body><h1>This is our title</h1><div><p>John</p><p>Jane</p><p>Eric</p></div></body></html>");
+}
+
+TEST_CASE("Rendering a Document does not allocate")
+{
+	Web::DocumentBuilder builder;
+	builder.open<Web::Ul>();
+	builder.element<Web::Li>("one");
+	builder.element<Web::Li>("two");
+	builder.close();
+	const auto doc = builder.finish();
+
+	char storage[64];
+	Web::FixedBuffer sink(storage, sizeof(storage));
+	Web::RenderError error;
+	REQUIRE_NO_ALLOCATIONS(error = Web::render(sink, doc));
+	REQUIRE(!error);
+	REQUIRE(sink.view() == "<ul><li>one</li><li>two</li></ul>");
+}
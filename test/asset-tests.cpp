@@ -0,0 +1,34 @@
+#include "catch.hpp"
+#include "support/to-string.hpp"
+#include <asset.hpp>
+#include <template.hpp>
+#include <web-assets/footer_html.hpp>
+#include <web-assets/icon_svg.hpp>
+#include <string>
+
+using Web::Test::toString;
+
+static_assert(Web::Assets::icon_svg.size() == 95);
+static_assert(Web::Assets::icon_svg.view().substr(0, 4) == "<svg");
+static_assert(Web::Assets::footer_html.getName() == "footer.html");
+
+TEST_CASE("Embedded assets hold the file contents")
+{
+	REQUIRE(Web::Assets::footer_html.view() == "<footer class=\"site-footer\"><p>&copy; Example Ltd</p></footer>\n");
+	REQUIRE(Web::Assets::footer_html.getHash() != Web::Assets::icon_svg.getHash());
+}
+
+TEST_CASE("Embedded assets render as children")
+{
+	auto d = Web::Div{ Web::Assets::icon_svg };
+	REQUIRE(toString(d) == "<div>" + std::string(Web::Assets::icon_svg.view()) + "</div>");
+}
+
+TEST_CASE("Embedded assets fold into template static markup")
+{
+	const Web::Template<std::string> tmpl{
+		Web::Body{ Web::H1{ Web::Slot<0, std::string>{} }, Web::Assets::footer_html }
+	};
+
+	REQUIRE(tmpl.segmentCount() == 3);
+}
@@ -0,0 +1,159 @@
+#include "catch.hpp"
+#include "support/to-string.hpp"
+#include <async.hpp>
+#include <generator.hpp>
+#include <coroutine>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <unistd.h>
+
+using Web::Test::toString;
+#endif
+
+namespace {
+Web::Ul bigList(int count, const std::string& prefix) {
+	std::vector<Web::Li> items;
+	for (int i = 0; i < count; ++i) {
+		items.push_back(Web::Li{ prefix, i });
+	}
+	return Web::Ul{ std::move(items) };
+}
+
+Web::Generator<Web::Li> generatedItems(int count) {
+	for (int i = 0; i < count; ++i) {
+		co_yield Web::Li{ i };
+	}
+}
+
+template <typename T>
+std::string renderToString(const T& node, Web::AsyncRenderOptions options = {}) {
+	std::string out;
+	Web::StringSink sink(out);
+	auto task = Web::renderAsync(sink, node, options);
+	task.start();
+	REQUIRE(task.isDone());
+	REQUIRE(task.getResult());
+	return out;
+}
+}
+
+TEST_CASE("renderAsync matches the synchronous render")
+{
+	const auto page = Web::Html{
+		Web::Body{
+			Web::Div{ Web::Attr{ Web::Class{ "list" }, Web::Id<"items">{} }, bigList(100, "item ") },
+			Web::Br{},
+			Web::Profiled{ "footer", Web::P{ "Footer ", 3.5 } }
+		}
+	};
+	REQUIRE(renderToString(page) == toString(page));
+	REQUIRE(renderToString(page, { .chunkSize = 1 }) == toString(page));
+}
+
+TEST_CASE("renderAsync walks generator children")
+{
+	REQUIRE(renderToString(Web::Ul{ generatedItems(3) }) == "<ul><li>0</li><li>1</li><li>2</li></ul>");
+}
+
+#ifndef _WIN32
+namespace {
+// Reads one end of a socket pair until the writer closes it
+class Reader {
+	std::string bytes;
+	std::thread thread;
+public:
+	explicit Reader(int fd) :
+		thread([this, fd] {
+			char buffer[4096];
+			ssize_t count;
+			while ((count = ::read(fd, buffer, sizeof(buffer))) > 0) {
+				bytes.append(buffer, static_cast<std::size_t>(count));
+			}
+			::close(fd);
+		})
+	{}
+	const std::string& finish() {
+		thread.join();
+		return bytes;
+	}
+};
+
+struct SocketPair {
+	int writer;
+	int reader;
+
+	SocketPair() {
+		int fds[2];
+		REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+		writer = fds[0];
+		reader = fds[1];
+		const int size = 4096;
+		::setsockopt(writer, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+	}
+};
+
+Web::Task<> renderAndClose(Web::FdSink& sink, const Web::Ul& list, int fd, std::vector<int>& finished, int id) {
+	const bool ok = co_await Web::renderAsync(sink, list, { .chunkSize = 1024 });
+	REQUIRE(ok);
+	::close(fd);
+	finished.push_back(id);
+}
+}
+
+TEST_CASE("EventLoop interleaves renders to slow sockets")
+{
+	const auto first = bigList(5000, "first ");
+	const auto second = bigList(5000, "second ");
+
+	Web::EventLoop loop;
+	SocketPair a;
+	SocketPair b;
+	Web::FdSink sinkA(loop, a.writer, { .highWatermark = 8 * 1024, .lowWatermark = 2 * 1024 });
+	Web::FdSink sinkB(loop, b.writer, { .highWatermark = 8 * 1024, .lowWatermark = 2 * 1024 });
+	std::vector<int> finished;
+	loop.spawn(renderAndClose(sinkA, first, a.writer, finished, 1));
+	loop.spawn(renderAndClose(sinkB, second, b.writer, finished, 2));
+
+	// Both renders are suspended on full sockets before anything is read
+	REQUIRE(sinkA.getWaitCount() == 1);
+	REQUIRE(sinkB.getWaitCount() == 1);
+
+	Reader readerA(a.reader);
+	Reader readerB(b.reader);
+	loop.run();
+
+	REQUIRE(readerA.finish() == toString(first));
+	REQUIRE(readerB.finish() == toString(second));
+	REQUIRE(finished.size() == 2);
+	REQUIRE(sinkA.getWaitCount() > 1);
+	REQUIRE(!sinkA.hasFailed());
+}
+
+TEST_CASE("FdSink reports a closed reader as a failed render")
+{
+	Web::EventLoop loop;
+	SocketPair pair;
+	::close(pair.reader);
+	Web::FdSink sink(loop, pair.writer);
+
+	const auto list = bigList(10, "");
+	loop.spawn(Web::renderAsync(sink, list));
+	loop.run();
+	REQUIRE(sink.hasFailed());
+	::close(pair.writer);
+}
+
+TEST_CASE("EventLoop rejects tasks that nothing can resume")
+{
+	Web::EventLoop loop;
+	loop.spawn([]() -> Web::Task<> {
+		co_await std::suspend_always{};
+	}());
+	REQUIRE_THROWS_AS(loop.run(), const std::logic_error&);
+}
+#endif
@@ -0,0 +1,131 @@
+#include "catch.hpp"
+#include "support/to-string.hpp"
+#include <attributes.hpp>
+#include <render.hpp>
+#include <sstream>
+#include <string>
+
+using Web::Test::toString;
+
+TEST_CASE("Attributes take values of their type")
+{
+	const auto link = Web::A{
+		Web::Attr{
+			Web::Attribute<"href">{ Web::Url{ "/search?q=web cpp" } },
+			Web::Attribute<"title">{ std::string("Search") },
+			Web::Attribute<"tabindex">{ 2 }
+		},
+		"Search"
+	};
+	REQUIRE(toString(link) == R"(<a href="/search?q=web%20cpp" title="Search" tabindex="2">Search</a>)");
+}
+
+TEST_CASE("Boolean attributes are written only when true")
+{
+	REQUIRE(toString(Web::Div{ Web::Attr{ Web::Attribute<"hidden">{ true } } }) == "<div hidden></div>");
+	REQUIRE(toString(Web::Div{ Web::Attr{ Web::Attribute<"hidden">{ false } } }) == "<div></div>");
+}
+
+TEST_CASE("Data attributes take text and numbers")
+{
+	const auto row = Web::Tr{
+		Web::Attr{ Web::Data<"row-id">{ 42 }, Web::Data<"state">{ "open" }, Web::Data<"kind", "order">{} }
+	};
+	REQUIRE(toString(row) == R"(<tr data-row-id="42" data-state="open" data-kind="order"></tr>)");
+}
+
+TEST_CASE("Attributes known at compile time are folded into the tag")
+{
+	const auto input = Web::Div{ Web::Attr{ Web::Class<"field">{}, Web::Attribute<"role", "group">{} } };
+	REQUIRE(toString(input) == R"(<div class="field" role="group"></div>)");
+}
+
+TEST_CASE("Urls percent-encode what cannot appear in an attribute")
+{
+	REQUIRE(Web::Url{ "/a b\"<c>" }.view() == "/a%20b%22%3Cc%3E");
+	REQUIRE(Web::Url{ "/caf\xC3\xA9" }.view() == "/caf%C3%A9");
+	REQUIRE(Web::Url{ "https://example.com/?a=1&b=2#top" }.view() == "https://example.com/?a=1&b=2#top");
+}
+
+TEST_CASE("Text attribute values cannot end their quotes")
+{
+	const std::string title = "say \"hi\" & bye\" onclick=\"x";
+	REQUIRE(toString(Web::Div{ Web::Attr{ Web::Attribute<"title">{ title } } })
+		== R"(<div title="say &quot;hi&quot; &amp; bye&quot; onclick=&quot;x"></div>)");
+	REQUIRE(toString(Web::Div{ Web::Attr{ Web::Data<"note">{ "\"" } } }) == R"(<div data-note="&quot;"></div>)");
+
+	Web::AttributeSet attributes;
+	attributes.add("alt", "a \"b\"");
+	attributes.add("data-x", "&");
+	REQUIRE(toString(Web::Img{ Web::Attr{ std::move(attributes) } }) == R"(<img alt="a &quot;b&quot;" data-x="&amp;">)");
+
+	REQUIRE(toString(Web::P{ Web::Attr{ Web::Attribute<"title", "Tom \"&\" Jerry">{} } })
+		== toString(Web::P{ Web::Attr{ Web::Attribute<"title">{ "Tom \"&\" Jerry" } } }));
+	static_assert(Web::Attribute<"title", "Tom \"&\" Jerry">::text.view() == R"( title="Tom &quot;&amp;&quot; Jerry")");
+
+	constexpr auto page = Web::renderStatic([] { return Web::P{ Web::Attr{ Web::Attribute<"title">{ "\"&" } } }; });
+	REQUIRE(page.view() == R"(<p title="&quot;&amp;"></p>)");
+}
+
+TEST_CASE("Attribute sets reject duplicate names")
+{
+	using Result = Web::AttributeSet::AddResult;
+	Web::AttributeSet attributes;
+	REQUIRE(attributes.add("title", "First") == Result::Inserted);
+	REQUIRE(attributes.add("width", 120) == Result::Inserted);
+	REQUIRE(attributes.add("disabled", true) == Result::Inserted);
+	REQUIRE(attributes.add("href", Web::Url{ "/next page" }) == Result::Inserted);
+	REQUIRE(attributes.add("data-user", "ann") == Result::Inserted);
+	REQUIRE(attributes.add("readonly", false) == Result::Inserted);
+
+	REQUIRE(attributes.add("title", "Second") == Result::Duplicate);
+	REQUIRE(attributes.add("width", 80) == Result::Duplicate);
+	REQUIRE(attributes.add("readonly", true) == Result::Duplicate);
+	REQUIRE(attributes.add("data-user", "bob") == Result::Duplicate);
+
+	REQUIRE(attributes.contains("readonly"));
+	REQUIRE_FALSE(attributes.contains("alt"));
+	REQUIRE(attributes.size() == 5);
+
+	REQUIRE(toString(Web::Div{ Web::Attr{ Web::Class<"card">{}, std::move(attributes) } })
+		== R"(<div class="card" title="First" width="120" disabled href="/next%20page" data-user="ann"></div>)");
+}
+
+TEST_CASE("Attribute sets reject unknown names and values of the wrong type")
+{
+	using Result = Web::AttributeSet::AddResult;
+	Web::AttributeSet attributes;
+	REQUIRE(attributes.add("onclick", "run()") == Result::Invalid);
+	REQUIRE(attributes.add("data-User", "ann") == Result::Invalid);
+	REQUIRE(attributes.add("data-flag", true) == Result::Invalid);
+	REQUIRE(attributes.add("width", "wide") == Result::Invalid);
+	REQUIRE(attributes.add("hidden", "yes") == Result::Invalid);
+	REQUIRE(attributes.add("href", "/next") == Result::Invalid);
+
+	// A rejected value does not take the name
+	REQUIRE(attributes.add("width", 120) == Result::Inserted);
+	REQUIRE(attributes.size() == 1);
+	REQUIRE(toString(Web::Div{ Web::Attr{ std::move(attributes) } }) == R"(<div width="120"></div>)");
+}
+
+TEST_CASE("Numbers that cannot be formatted leave the attribute out and fail the stream")
+{
+	std::stringstream ss;
+	ss << Web::Div{ Web::Attr{ Web::Attribute<"width">{ 1, Web::NumberFormat{ .precision = 20000 } } } };
+	REQUIRE(ss.fail());
+
+	Web::AttributeSet attributes;
+	REQUIRE(attributes.add("width", 1, Web::NumberFormat{ .precision = 20000 }) == Web::AttributeSet::AddResult::Invalid);
+	REQUIRE(attributes.size() == 0);
+}
+
+TEST_CASE("Every standard attribute has its own slot")
+{
+	for (std::size_t i = 0; i < Web::standardAttributeCount; ++i) {
+		const std::string_view name = Web::standardAttributes[i].name;
+		REQUIRE(Web::findStandardAttribute(name) == i);
+		REQUIRE(Web::standardAttributePrefix(i).substr(1, name.size()) == name);
+	}
+	REQUIRE_FALSE(Web::findStandardAttribute("data-x"));
+	REQUIRE_FALSE(Web::findStandardAttribute("hre"));
+}
@@ -1,17 +1,10 @@
 #include "catch.hpp"
+#include "support/to-string.hpp"
 #include <web.hpp>
 #include <iostream>
 #include <string>
-#include <sstream>
 
-namespace {
-template <typename T>
-std::string toString(T&& t) {
-	std::stringstream ss;
-	ss << t;
-	return ss.str();
-}
-}
+using Web::Test::toString;
 
 TEST_CASE("P can contain text")
 {
@@ -111,4 +104,92 @@ TEST_CASE("Div can have multiple attributes")
 
 	auto divText = toString(d);
 	REQUIRE(divText == "<div class=\"basic\" id=\"first\"></div>");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Div can have compile time attributes")
+{
+	auto d = Web::Div {
+		Web::Attr {
+			Web::Class<"center">{},
+			Web::Id<"main">{}
+		},
+		"text"
+	};
+
+	auto divText = toString(d);
+	REQUIRE(divText == R"(<div class="center" id="main">text</div>)");
+}
+
+TEST_CASE("Compile time and runtime attributes can be mixed")
+{
+	auto d = Web::Div {
+		Web::Attr {
+			Web::Class<"center">{},
+			Web::Id{ "dynamic" }
+		}
+	};
+
+	auto divText = toString(d);
+	REQUIRE(divText == R"(<div class="center" id="dynamic"></div>)");
+}
+
+TEST_CASE("Void elements have no closing tag")
+{
+	auto p = Web::P {
+		Web::Img{ Web::Attr{ Web::Class<"icon">{} } }
+	};
+
+	REQUIRE(toString(p) == R"(<p><img class="icon"></p>)");
+}
+
+TEST_CASE("Lists and tables follow the content model")
+{
+	auto list = Web::Ul {
+		Web::Li{ "first" },
+		Web::Li{ Web::P{ "second" } }
+	};
+	REQUIRE(toString(list) == "<ul><li>first</li><li><p>second</p></li></ul>");
+
+	auto table = Web::Table {
+		Web::Tbody {
+			Web::Tr{ Web::Td{ 1 }, Web::Td{ Web::A{ "link" } } }
+		}
+	};
+	REQUIRE(toString(table) == "<table><tbody><tr><td>1</td><td><a>link</a></td></tr></tbody></table>");
+}
+
+TEST_CASE("Html can contain a head")
+{
+	auto doc = Web::Html {
+		Web::Head{ Web::Title{ "Title" } },
+		Web::Body{}
+	};
+	REQUIRE(toString(doc) == "<html><head><title>Title</title></head><body></body></html>");
+}
+
+TEST_CASE("Copies and moves keep their children")
+{
+	auto short_text = Web::P{ "a" };
+	auto long_text = Web::P{ Web::Attr{ Web::Class{ "note" } }, std::string(64, 'b') };
+
+	auto copy = short_text;
+	auto long_copy = long_text;
+	REQUIRE(toString(copy) == "<p>a</p>");
+	REQUIRE(toString(long_copy) == R"(<p class="note">)" + std::string(64, 'b') + "</p>");
+
+	auto moved = std::move(copy);
+	copy = long_copy;
+	long_copy = std::move(moved);
+	REQUIRE(toString(copy) == toString(long_text));
+	REQUIRE(toString(long_copy) == toString(short_text));
+}
+
+TEST_CASE("Markup rendered at compile time streams like the tree")
+{
+	static constexpr auto page = Web::renderStatic([] {
+		return Web::Div{ Web::Attr{ Web::Class<"center">{} }, Web::P{ "Hello" }, Web::Br{} };
+	});
+	const auto tree = Web::Div{ Web::Attr{ Web::Class<"center">{} }, Web::P{ "Hello" }, Web::Br{} };
+	REQUIRE(toString(page) == toString(tree));
+	REQUIRE(toString(Web::Body{ page }) == "<body>" + toString(tree) + "</body>");
+}
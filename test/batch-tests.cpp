@@ -0,0 +1,92 @@
+#include "catch.hpp"
+#include <batch.hpp>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct User {
+	std::string name;
+	int unread;
+};
+
+const auto buildGreeting = [](const auto& name, const auto& unread) {
+	return Web::Div{ Web::H1{ "Hello ", name }, Web::P{ "Unread: ", unread } };
+};
+
+const auto extractUser = [](const User& user) {
+	return std::tie(user.name, user.unread);
+};
+
+std::string renderOne(const User& user) {
+	std::stringstream ss;
+	ss << buildGreeting(user.name, user.unread);
+	return ss.str();
+}
+
+std::vector<User> makeUsers(int count) {
+	std::vector<User> users;
+	for (int i = 0; i < count; ++i) {
+		users.push_back(User{ "user" + std::to_string(i), i * 3 });
+	}
+	return users;
+}
+}
+
+TEST_CASE("Batch renders each record like a tree built for it")
+{
+	const auto users = makeUsers(3);
+	const auto output = Web::renderBatch(std::span(users), buildGreeting, extractUser);
+
+	REQUIRE(output.size() == 3);
+	for (std::size_t i = 0; i < users.size(); ++i) {
+		REQUIRE(output.document(i) == renderOne(users[i]));
+	}
+	REQUIRE(output.getOffsets().front() == 0);
+	REQUIRE(output.getOffsets().back() == output.getBytes().size());
+}
+
+TEST_CASE("Batch takes the documented call on a mutable vector")
+{
+	auto users = makeUsers(2);
+	const auto output = Web::renderBatch(users,
+		[](const auto& name, const auto& count) { return Web::P{ "Hello ", name, ", you have ", count, " messages" }; },
+		[](const User& user) { return std::tuple(user.name, user.unread); });
+
+	REQUIRE(output.document(1) == "<p>Hello user1, you have 3 messages</p>");
+
+	const auto fromSpan = Web::renderBatch(std::span(users), buildGreeting, extractUser);
+	REQUIRE(fromSpan.document(0) == renderOne(users[0]));
+}
+
+TEST_CASE("Batch of no records is empty")
+{
+	const std::vector<User> users;
+	const auto output = Web::renderBatch(std::span(users), buildGreeting, extractUser, { .threads = 4 });
+
+	REQUIRE(output.size() == 0);
+	REQUIRE(output.getBytes().empty());
+}
+
+TEST_CASE("Batch rendered on several threads keeps record order")
+{
+	const auto users = makeUsers(101);
+	const auto single = Web::renderBatch(std::span(users), buildGreeting, extractUser);
+	const auto parallel = Web::renderBatch(std::span(users), buildGreeting, extractUser, { .threads = 4, .reservePerDocument = 64 });
+
+	REQUIRE(parallel.getBytes() == single.getBytes());
+	REQUIRE(parallel.getOffsets() == single.getOffsets());
+	REQUIRE(parallel.document(100) == renderOne(users[100]));
+}
+
+TEST_CASE("Batch can reuse a precompiled template")
+{
+	const Web::Template<std::string> skeleton{ Web::P{ Web::Slot<0, std::string>{} } };
+	const std::vector<std::string> names{ "a", "b" };
+	const auto output = Web::renderBatch(skeleton, std::span(names),
+		[](const std::string& name) { return std::tie(name); });
+
+	REQUIRE(output.getBytes() == "<p>a</p><p>b</p>");
+	REQUIRE(output.document(1) == "<p>b</p>");
+}
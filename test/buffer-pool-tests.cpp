@@ -0,0 +1,91 @@
+#include "catch.hpp"
+#include "support/allocation-counter.hpp"
+#include "support/to-string.hpp"
+#include <buffer-pool.hpp>
+#include <web.hpp>
+#include <thread>
+#include <string>
+#include <vector>
+
+using Web::Test::toString;
+
+namespace {
+Web::Ul list(int count) {
+	std::vector<Web::Li> items;
+	for (int i = 0; i < count; ++i) {
+		items.push_back(Web::Li{ "item ", i });
+	}
+	return Web::Ul{ std::move(items) };
+}
+
+struct SmallPage {};
+struct LargePage {};
+}
+
+TEST_CASE("RenderBuffer keeps output across chunks in order")
+{
+	Web::BufferPool pool({ .chunkSize = 64 });
+	const auto page = list(100);
+	auto buffer = pool.acquire<LargePage>();
+	Web::render(buffer, page);
+
+	REQUIRE(buffer.size() == toString(page).size());
+	REQUIRE(buffer.str() == toString(page));
+
+	std::size_t chunks = 0;
+	buffer.forEachChunk([&](std::string_view chunk) {
+		++chunks;
+		REQUIRE(chunk.size() <= 64u);
+	});
+	REQUIRE(chunks == (buffer.size() + 63) / 64);
+}
+
+TEST_CASE("BufferPool learns a size estimate per document type")
+{
+	Web::BufferPool pool({ .chunkSize = 64, .smoothing = 0.5 });
+	REQUIRE(pool.getEstimate<SmallPage>() == 0u);
+
+	{
+		auto buffer = pool.acquire<SmallPage>();
+		Web::render(buffer, Web::P{ std::string(100, 'x') });
+	}
+	REQUIRE(pool.getEstimate<SmallPage>() == 107u);
+	{
+		auto buffer = pool.acquire<SmallPage>();
+		Web::render(buffer, Web::P{ std::string(200, 'x') });
+	}
+	REQUIRE(pool.getEstimate<SmallPage>() == 157u);
+	REQUIRE(pool.getEstimate<LargePage>() == 0u);
+}
+
+TEST_CASE("BufferPool caps the memory it keeps")
+{
+	Web::BufferPool pool({ .chunkSize = 64, .maxPooledBytes = 256 });
+	{
+		auto buffer = pool.acquire<LargePage>();
+		Web::render(buffer, list(100));
+	}
+	REQUIRE(pool.getPooledBytes() == 256u);
+}
+
+TEST_CASE("Pooled renders stop allocating once the pool is warm")
+{
+	Web::BufferPool pool({ .chunkSize = 1024 });
+	const auto page = list(500);
+	for (int i = 0; i < 3; ++i) {
+		auto buffer = pool.acquire<LargePage>();
+		Web::render(buffer, page);
+	}
+
+	REQUIRE_NO_ALLOCATIONS(
+		auto buffer = pool.acquire<LargePage>();
+		Web::render(buffer, page)
+	);
+}
+
+TEST_CASE("Each thread has its own pool")
+{
+	Web::BufferPool* other = nullptr;
+	std::thread([&] { other = &Web::BufferPool::local(); }).join();
+	REQUIRE(other != &Web::BufferPool::local());
+}
@@ -0,0 +1,71 @@
+#include "catch.hpp"
+#include "support/allocation-counter.hpp"
+#include "support/to-string.hpp"
+#include <class-list.hpp>
+#include <render.hpp>
+#include <string>
+
+using Web::Test::toString;
+
+TEST_CASE("Static classes are written as one prefix")
+{
+	const auto div = Web::Div{ Web::Attr{ Web::ClassList<"flex", "items-center", "gap-2">{} } };
+	REQUIRE(toString(div) == R"(<div class="flex items-center gap-2"></div>)");
+}
+
+TEST_CASE("Conditional and runtime classes follow the static ones")
+{
+	const std::string accent = "text-blue-600 font-bold";
+	const bool selected = true;
+	const bool disabled = false;
+	const auto button = Web::Span{
+		Web::Attr{
+			Web::ClassList<"px-4", "py-2">{ Web::ClassIf<"ring-2">{ selected }, Web::ClassIf<"opacity-50">{ disabled }, accent }
+		},
+		"Save"
+	};
+	REQUIRE(toString(button) == R"(<span class="px-4 py-2 ring-2 text-blue-600 font-bold">Save</span>)");
+}
+
+TEST_CASE("Each class is written once")
+{
+	Web::ClassList<"flex", "p-4"> classes{ "p-4 m-2", Web::ClassIf<"m-2">{ true }, "  flex\tm-2 underline " };
+	classes.addIf(true, "underline").addIf(false, "hidden").add(Web::ClassIf<"flex">{ true });
+
+	REQUIRE(classes.size() == 4);
+	REQUIRE(classes.contains("underline"));
+	REQUIRE_FALSE(classes.contains("hidden"));
+	REQUIRE(toString(Web::Div{ Web::Attr{ std::move(classes) } }) == R"(<div class="flex p-4 m-2 underline"></div>)");
+}
+
+TEST_CASE("A list without classes writes no attribute")
+{
+	REQUIRE(toString(Web::Div{ Web::Attr{ Web::ClassList<>{ Web::ClassIf<"hidden">{ false } } } }) == "<div></div>");
+	REQUIRE(toString(Web::Div{ Web::Attr{ Web::ClassList<>{ "a", "b a" } } }) == R"(<div class="a b"></div>)");
+}
+
+TEST_CASE("Long class lists spill out of the inline entries")
+{
+	Web::ClassList<> classes;
+	std::string expected;
+	for (int i = 0; i < 40; ++i) {
+		std::string name = "c";
+		name += std::to_string(i);
+		classes.add(name);
+		classes.add(name);
+		if (i != 0) {
+			expected += ' ';
+		}
+		expected += name;
+	}
+	REQUIRE(classes.size() == 40);
+	REQUIRE(toString(Web::P{ Web::Attr{ std::move(classes) } }) == R"(<p class=")" + expected + R"("></p>)");
+}
+
+TEST_CASE("Static and conditional classes do not allocate")
+{
+	const bool active = true;
+	REQUIRE_NO_ALLOCATIONS(Web::ClassList<"flex", "items-center", "justify-between", "p-4", "rounded-lg", "shadow">{
+		Web::ClassIf<"bg-blue-500">{ active }, Web::ClassIf<"text-white">{ active }, Web::ClassIf<"hidden">{ !active }
+	});
+}
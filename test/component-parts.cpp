@@ -0,0 +1,14 @@
+// Components built in their own translation unit, as a large page would be
+#include <component.hpp>
+#include <string>
+
+Web::Component makeNavigation(int active) {
+	return Web::Component{ Web::Nav{ Web::Ul{
+		Web::Li{ Web::A{ active == 0 ? "[Home]" : "Home" } },
+		Web::Li{ Web::A{ active == 1 ? "[About]" : "About" } }
+	} } };
+}
+
+Web::Component makeFooter(const std::string& owner) {
+	return Web::Component{ Web::Footer{ Web::P{ "(c) ", owner } } };
+}
@@ -0,0 +1,58 @@
+#include "catch.hpp"
+#include "support/allocation-counter.hpp"
+#include "support/to-string.hpp"
+#include <component.hpp>
+#include <memory>
+#include <string>
+
+using Web::Test::toString;
+
+// Defined in component-parts.cpp
+Web::Component makeNavigation(int active);
+Web::Component makeFooter(const std::string& owner);
+
+namespace {
+class Greeting : public Web::Component::Renderer {
+	std::string name;
+
+public:
+	explicit Greeting(std::string name) :
+		name(std::move(name))
+	{}
+
+	void render(std::ostream& stream) const override {
+		stream << "<p>Hello, " << name << "</p>";
+	}
+};
+}
+
+TEST_CASE("Component renders its subtree")
+{
+	const Web::Component component{ Web::Div{ Web::Attr{ Web::Class<"box">{} }, Web::P{ "text ", 42 } } };
+
+	REQUIRE(toString(component) == R"(<div class="box"><p>text 42</p></div>)");
+	REQUIRE(toString(Web::Body{ component, Web::P{ "after" } }) == R"(<body><div class="box"><p>text 42</p></div><p>after</p></body>)");
+}
+
+TEST_CASE("Component can be built in another translation unit")
+{
+	const auto page = Web::Html{ Web::Body{ makeNavigation(1), Web::Main{ Web::P{ "content" } }, makeFooter("Example") } };
+
+	REQUIRE(toString(page) == "<html><body><nav><ul><li><a>Home</a></li><li><a>[About]</a></li></ul></nav>"
+		"<main><p>content</p></main><footer><p>(c) Example</p></footer></body></html>");
+}
+
+TEST_CASE("Component can wrap a custom renderer")
+{
+	const Web::Component component{ std::make_shared<const Greeting>("world") };
+
+	REQUIRE(toString(Web::Div{ component }) == "<div><p>Hello, world</p></div>");
+}
+
+TEST_CASE("Copies of a component share the subtree")
+{
+	const auto footer = makeFooter("Example");
+	REQUIRE_NO_ALLOCATIONS(Web::Component copy = footer);
+	const auto copy = footer;
+	REQUIRE(toString(copy) == toString(footer));
+}
@@ -0,0 +1,85 @@
+#include "catch.hpp"
+#include "support/to-string.hpp"
+#include <data-table.hpp>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using Web::Test::toString;
+
+TEST_CASE("DataTable renders a header row and a row per value")
+{
+	const std::vector<std::int64_t> ids{ 1, 2 };
+	const std::vector<std::string_view> names{ "Ann", "Bob" };
+	const Web::DataTable table{
+		Web::Column{ "Id", std::span(ids) },
+		Web::Column{ "Name", std::span(names) }
+	};
+
+	REQUIRE(table.getRowCount() == 2);
+	REQUIRE(toString(table) ==
+		"<table><thead><tr><th>Id</th><th>Name</th></tr></thead><tbody>"
+		"<tr><td>1</td><td>Ann</td></tr>"
+		"<tr><td>2</td><td>Bob</td></tr>"
+		"</tbody></table>");
+}
+
+TEST_CASE("DataTable columns can have a number format or a formatter")
+{
+	const std::vector<double> prices{ 1234.5, 0.25 };
+	const std::vector<int> stock{ 3, 0 };
+	const Web::DataTable table{
+		Web::Column{ "Price", std::span(prices), Web::NumberFormat{ .precision = 2, .thousandsSeparator = ',' } },
+		Web::Column{ "In stock", std::span(stock), [](Web::CellWriter& out, int count) {
+			out.write(count > 0 ? "yes" : "no");
+		} }
+	};
+
+	REQUIRE(toString(table) ==
+		"<table><thead><tr><th>Price</th><th>In stock</th></tr></thead><tbody>"
+		"<tr><td>1,234.50</td><td>yes</td></tr>"
+		"<tr><td>0.25</td><td>no</td></tr>"
+		"</tbody></table>");
+}
+
+TEST_CASE("DataTable with no rows renders an empty body")
+{
+	const std::vector<int> empty;
+	REQUIRE(toString(Web::DataTable{ Web::Column{ "A", std::span(empty) } }) ==
+		"<table><thead><tr><th>A</th></tr></thead><tbody></tbody></table>");
+}
+
+TEST_CASE("DataTable rejects columns of different lengths")
+{
+	const std::vector<int> ids{ 1, 2, 3 };
+	const std::vector<std::string_view> names{ "Ann" };
+	REQUIRE_THROWS_AS((Web::DataTable{ Web::Column{ "Id", std::span(ids) }, Web::Column{ "Name", std::span(names) } }),
+		const std::invalid_argument&);
+	REQUIRE_THROWS_AS((Web::DataTable{ Web::Column{ "Name", std::span(names) }, Web::Column{ "Id", std::span(ids) } }),
+		const std::invalid_argument&);
+}
+
+TEST_CASE("DataTable output larger than its buffer is complete")
+{
+	std::vector<int> values(10000);
+	for (int i = 0; i < 10000; ++i) {
+		values[i] = i;
+	}
+	const auto html = toString(Web::Div{ Web::DataTable{ Web::Column{ "N", std::span(values) } } });
+
+	REQUIRE(html.find("<tr><td>0</td></tr><tr><td>1</td></tr>") != std::string::npos);
+	REQUIRE(html.find("<tr><td>9998</td></tr><tr><td>9999</td></tr></tbody></table></div>") != std::string::npos);
+}
+
+TEST_CASE("DataTable leaves out numbers it cannot format and fails the stream")
+{
+	const std::vector<int> values{ 1 };
+	std::stringstream ss;
+	ss << Web::DataTable{ Web::Column{ "N", std::span(values), Web::NumberFormat{ .precision = 20000 } } };
+
+	REQUIRE(ss.bad());
+	REQUIRE(ss.str() == "<table><thead><tr><th>N</th></tr></thead><tbody><tr><td></td></tr></tbody></table>");
+}
@@ -0,0 +1,264 @@
+#include "catch.hpp"
+#include "support/allocation-counter.hpp"
+#include "support/to-string.hpp"
+#include <document.hpp>
+#include <string>
+#include <string_view>
+
+using Web::Test::toString;
+
+TEST_CASE("Document renders nested elements and text")
+{
+	Web::DocumentBuilder builder;
+	builder.open<Web::Html>();
+	builder.open<Web::Body>();
+	builder.element<Web::H1>("Title");
+	builder.open<Web::Div>();
+	builder.element<Web::P>("first");
+	builder.element<Web::P>("second");
+	builder.close();
+	builder.close();
+	builder.close();
+	auto doc = builder.finish();
+
+	REQUIRE(toString(doc) == "<html><body><h1>Title</h1><div><p>first</p><p>second</p></div></body></html>");
+}
+
+TEST_CASE("Document elements can have attributes")
+{
+	Web::DocumentBuilder builder;
+	builder.open<Web::Div>()
+		.attribute(Web::Class{ "basic" })
+		.attribute(Web::Id<"first">{})
+		.attribute("data-x", "1");
+	builder.text("text");
+	builder.close();
+	auto doc = builder.finish();
+
+	REQUIRE(toString(doc) == R"(<div class="basic" id="first" data-x="1">text</div>)");
+}
+
+TEST_CASE("Document can have several roots and numeric text")
+{
+	Web::DocumentBuilder builder;
+	builder.element<Web::P>("Count: ", 42);
+	builder.open<Web::P>().text(1234.5, { .precision = 2, .thousandsSeparator = ',' }).close();
+	auto doc = builder.finish();
+
+	REQUIRE(toString(doc) == "<p>Count: 42</p><p>1,234.50</p>");
+}
+
+TEST_CASE("Document stores children contiguously")
+{
+	Web::DocumentBuilder builder;
+	builder.open<Web::Div>();
+	builder.element<Web::P>("a");
+	builder.element<Web::P>("b");
+	builder.close();
+	auto doc = builder.finish();
+
+	const auto [first, last] = doc.getRoots();
+	REQUIRE(last - first == 1);
+	const auto& div = doc.getNodes()[*first];
+	REQUIRE(doc.getText(div.text) == "div");
+	REQUIRE(div.childCount == 2);
+	const auto& second = doc.getNodes()[doc.getChildIndices()[div.firstChild + 1]];
+	REQUIRE(doc.getText(second.text) == "p");
+
+	// Tag names are stored once
+	REQUIRE(doc.getTextPool() == "divpab");
+}
+
+TEST_CASE("Document can be a child of an element")
+{
+	Web::DocumentBuilder builder;
+	builder.element<Web::P>("dynamic");
+	auto d = Web::Div{ builder.finish() };
+
+	REQUIRE(toString(d) == "<div><p>dynamic</p></div>");
+}
+
+TEST_CASE("Document builds and renders a million nodes")
+{
+	constexpr std::size_t rows = 250000;
+	Web::DocumentBuilder builder;
+	builder.reserve(rows * 4 + 1, rows, rows * 8);
+	Web::Document doc;
+	// Only the scratch stack holding the outer div's children regrows
+	REQUIRE_ALLOCATIONS_AT_MOST(16, [&] {
+		builder.open<Web::Div>();
+		for (std::size_t i = 0; i < rows; ++i) {
+			builder.open<Web::Div>().attribute(Web::Class<"row">{});
+			builder.element<Web::P>(i);
+			builder.close();
+		}
+		builder.close();
+		doc = builder.finish();
+	}());
+
+	std::string expected = "<div>";
+	for (std::size_t i = 0; i < rows; ++i) {
+		expected += R"(<div class="row"><p>)" + std::to_string(i) + "</p></div>";
+	}
+	expected += "</div>";
+
+	REQUIRE(doc.getNodes().size() == rows * 3 + 1);
+	REQUIRE(toString(doc) == expected);
+}
+
+TEST_CASE("Document builder drops misplaced calls and reports them")
+{
+	Web::DocumentBuilder builder;
+	builder.open<Web::P>().text("text").attribute("id", "late");
+	REQUIRE(builder.getError().code == Web::BuildError::Code::MisplacedAttribute);
+	builder.close().close();
+	builder.attribute("id", "none");
+	Web::BuildError error;
+	auto doc = builder.finish(&error);
+
+	REQUIRE(error.code == Web::BuildError::Code::MisplacedAttribute);
+	REQUIRE(toString(doc) == "<p>text</p>");
+	REQUIRE(!builder.getError());
+}
+
+TEST_CASE("Document builder reports a close without an open")
+{
+	Web::DocumentBuilder builder;
+	builder.close();
+	builder.element<Web::P>("text");
+	Web::BuildError error;
+	auto doc = builder.finish(&error);
+
+	REQUIRE(error.code == Web::BuildError::Code::UnmatchedClose);
+	REQUIRE(toString(doc) == "<p>text</p>");
+}
+
+TEST_CASE("Document builder closes elements left open")
+{
+	Web::DocumentBuilder builder;
+	builder.open<Web::Div>().open<Web::P>().text("text");
+	Web::BuildError error;
+	auto doc = builder.finish(&error);
+
+	REQUIRE(error.code == Web::BuildError::Code::UnclosedElement);
+	REQUIRE(toString(doc) == "<div><p>text</p></div>");
+}
+
+TEST_CASE("Document builder skips numbers that cannot be formatted")
+{
+	Web::DocumentBuilder builder;
+	builder.open<Web::P>().text(1, { .precision = 1000 }).close();
+	Web::BuildError error;
+	auto doc = builder.finish(&error);
+
+	REQUIRE(error.code == Web::BuildError::Code::InvalidNumber);
+	REQUIRE(doc.getNodes().size() == 1);
+	REQUIRE(toString(doc) == "<p></p>");
+}
+
+TEST_CASE("Document deeper than the inline render stack renders")
+{
+	constexpr int depth = 200;
+	Web::DocumentBuilder builder;
+	for (int i = 0; i < depth; ++i) {
+		builder.open<Web::Div>();
+	}
+	builder.text("deep");
+	for (int i = 0; i < depth; ++i) {
+		builder.close();
+	}
+	const auto doc = builder.finish();
+
+	std::string expected;
+	for (int i = 0; i < depth; ++i) {
+		expected += "<div>";
+	}
+	expected += "deep";
+	for (int i = 0; i < depth; ++i) {
+		expected += "</div>";
+	}
+	REQUIRE(toString(doc) == expected);
+}
+
+namespace {
+// A table whose rows repeat a few cell values, as a status page would
+Web::Document buildRepeatingTable(Web::DocumentBuilder& builder) {
+	builder.open<Web::Table>();
+	for (int row = 0; row < 100; ++row) {
+		builder.open<Web::Tr>();
+		builder.element<Web::Td>(row);
+		builder.open<Web::Td>().attribute(Web::Class<"status">{});
+		builder.element<Web::Span>(row % 3 == 0 ? "down" : "up");
+		builder.close();
+		builder.element<Web::Td>("-");
+		builder.close();
+	}
+	builder.close();
+	return builder.finish();
+}
+
+Web::Document buildRepeatingTable(Web::DocumentBuilderOptions options = {}) {
+	Web::DocumentBuilder builder(options);
+	return buildRepeatingTable(builder);
+}
+
+std::size_t countOf(std::string_view text, std::string_view part) {
+	std::size_t count = 0;
+	for (std::size_t at = text.find(part); at != std::string_view::npos; at = text.find(part, at + 1)) {
+		++count;
+	}
+	return count;
+}
+}
+
+TEST_CASE("Document builder can share identical subtrees")
+{
+	const auto plain = buildRepeatingTable();
+	Web::DocumentBuilder builder({ .deduplicateSubtrees = true });
+	const auto shared = buildRepeatingTable(builder);
+
+	REQUIRE(toString(shared) == toString(plain));
+	REQUIRE(shared.getNodes().size() < plain.getNodes().size());
+	REQUIRE(shared.getMemoryUsage() < plain.getMemoryUsage());
+	// Only the first two rows bring new status cells; every row after the
+	// first shares its span, status cell and "-" cell
+	REQUIRE(builder.getReusedSubtreeCount() == (100 - 2) * 3 + 1);
+	REQUIRE(plain.getNodes().size() - shared.getNodes().size() == builder.getRemovedNodeCount());
+
+	// The status cells point at one of two copies
+	const auto& table = shared.getNodes()[*shared.getRoots().first];
+	const auto& first = shared.getNodes()[shared.getChildIndices()[table.firstChild + 1]];
+	const auto& fourth = shared.getNodes()[shared.getChildIndices()[table.firstChild + 4]];
+	REQUIRE(shared.getChildIndices()[first.firstChild + 1] == shared.getChildIndices()[fourth.firstChild + 1]);
+}
+
+TEST_CASE("Document builder can cache the bytes of shared subtrees")
+{
+	const auto plain = buildRepeatingTable();
+	const auto cached = buildRepeatingTable({ .deduplicateSubtrees = true, .cacheSharedSubtrees = true });
+
+	REQUIRE(toString(cached) == toString(plain));
+	// Only the outermost shared subtrees are cached, so the spans inside the
+	// cached status cells are not stored again on their own
+	REQUIRE(countOf(cached.getTextPool(), "<span>down</span>") == 1);
+	REQUIRE(countOf(cached.getTextPool(), R"(<td class="status"><span>down</span></td>)") == 1);
+}
+
+TEST_CASE("Document builder only shares subtrees that are identical")
+{
+	Web::DocumentBuilder builder({ .deduplicateSubtrees = true });
+	builder.open<Web::Div>();
+	builder.open<Web::P>().attribute("title", "a").text("x").close();
+	builder.open<Web::P>().attribute("title", "b").text("x").close();
+	builder.open<Web::P>().text("x").close();
+	builder.open<Web::P>().raw("x").close();
+	builder.open<Web::P>().text("x").text("y").close();
+	builder.open<Web::P>().text("xy").close();
+	builder.open<Web::Span>().text("x").close();
+	builder.close();
+	const auto doc = builder.finish();
+
+	REQUIRE(builder.getReusedSubtreeCount() == 0);
+	REQUIRE(toString(doc) == R"(<div><p title="a">x</p><p title="b">x</p><p>x</p><p>x</p><p>x)"
+		R"(y</p><p>xy</p><span>x</span></div>)");
+}
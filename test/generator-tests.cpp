@@ -0,0 +1,98 @@
+#include "catch.hpp"
+#include "support/allocation-counter.hpp"
+#include "support/to-string.hpp"
+#include <generator.hpp>
+#include <render.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using Web::Test::toString;
+
+namespace {
+Web::Generator<Web::Li> numbers(int count, int* generated = nullptr) {
+	for (int i = 0; i < count; ++i) {
+		if (generated) {
+			++*generated;
+		}
+		co_yield Web::Li{ i };
+	}
+}
+
+Web::Generator<Web::P> failing() {
+	co_yield Web::P{ "before" };
+	throw std::runtime_error("cursor failed");
+}
+
+// Accepts a fixed number of bytes, then fails like a closed connection
+class LimitedBuffer : public std::streambuf {
+	std::size_t remaining;
+public:
+	explicit LimitedBuffer(std::size_t limit) :
+		remaining(limit)
+	{}
+protected:
+	std::streamsize xsputn(const char* /*s*/, std::streamsize count) override {
+		const auto accepted = std::min<std::size_t>(remaining, static_cast<std::size_t>(count));
+		remaining -= accepted;
+		return static_cast<std::streamsize>(accepted);
+	}
+	int_type overflow(int_type c) override {
+		if (remaining == 0) {
+			return traits_type::eof();
+		}
+		--remaining;
+		return traits_type::not_eof(c);
+	}
+};
+}
+
+TEST_CASE("Generator children render each yielded element")
+{
+	REQUIRE(toString(Web::Ul{ numbers(3) }) == "<ul><li>0</li><li>1</li><li>2</li></ul>");
+}
+
+TEST_CASE("Generator runs once")
+{
+	const auto list = Web::Ul{ numbers(2) };
+	REQUIRE(toString(list) == "<ul><li>0</li><li>1</li></ul>");
+	REQUIRE(toString(list) == "<ul></ul>");
+}
+
+TEST_CASE("Generator does not start until rendered")
+{
+	int generated = 0;
+	const auto list = Web::Ul{ numbers(5, &generated) };
+	REQUIRE(generated == 0);
+	toString(list);
+	REQUIRE(generated == 5);
+}
+
+TEST_CASE("Generator stops when the stream fails")
+{
+	int generated = 0;
+	LimitedBuffer buffer(20);
+	std::ostream stream(&buffer);
+	stream << Web::Ul{ numbers(1000, &generated) };
+
+	REQUIRE(!stream);
+	REQUIRE(generated < 10);
+}
+
+TEST_CASE("Generator exceptions reach the caller")
+{
+	std::stringstream ss;
+	REQUIRE_THROWS_AS(ss << Web::Div{ failing() }, const std::runtime_error&);
+}
+
+TEST_CASE("Generator renders in constant memory")
+{
+	std::string out;
+	out.reserve(1 << 20);
+	const auto small = WEB_ALLOCATIONS_IN(Web::render(out, Web::Ul{ numbers(10) }));
+	out.clear();
+	const auto large = WEB_ALLOCATIONS_IN(Web::render(out, Web::Ul{ numbers(50000) }));
+
+	REQUIRE(large == small);
+	REQUIRE(large <= 3u); // The coroutine frame, its shared state and the list's children
+}
@@ -1,5 +1,92 @@
 #include <meta.hpp>
+#include <web.hpp>
+#include <attributes.hpp>
+#include <class-list.hpp>
 
 static_assert(!contains_duplicates<int, char, double>::value);
 static_assert(contains_duplicates<int, char, double, int>::value);
-static_assert(!contains_duplicates<int>::value);
\ No newline at end of file
+static_assert(!contains_duplicates<int>::value);
+
+static_assert((fixed_string{ "ab" } + fixed_string{ "cd" }).view() == "abcd");
+static_assert(fixed_string{ "abc" }.size() == 3);
+
+static_assert(Web::Class<"center">::text.view() == R"( class="center")");
+static_assert(Web::Id<"main">::text.view() == R"( id="main")");
+static_assert(Web::StaticAttribute<Web::Class<"center">>);
+static_assert(!Web::StaticAttribute<Web::Class<>>);
+
+static_assert(Web::StaticTag<Web::Div>::open.view() == "<div>");
+static_assert(Web::StaticTag<Web::Div>::close.view() == "</div>");
+static_assert(Web::StaticTag<Web::Div, Web::Class<"center">, Web::Id<"main">>::open.view() == R"(<div class="center" id="main">)");
+
+// Runtime and compile time forms of an attribute count as duplicates
+static_assert(contains_duplicates<Web::attribute_key_t<Web::Class<>>, Web::attribute_key_t<Web::Class<"a">>>::value);
+static_assert(!contains_duplicates<Web::attribute_key_t<Web::Class<"a">>, Web::attribute_key_t<Web::Id<"a">>>::value);
+
+// Content model
+static_assert(Web::permits_child<Web::Div, Web::P>());
+static_assert(Web::permits_child<Web::P, Web::Span>());
+static_assert(Web::permits_child<Web::P, std::string>());
+static_assert(Web::permits_child<Web::P, const char(&)[5]>());
+static_assert(Web::permits_child<Web::P, int>());
+static_assert(Web::permits_child<Web::P, Web::Br>());
+static_assert(!Web::permits_child<Web::P, Web::Div>());
+static_assert(!Web::permits_child<Web::P, Web::P>());
+static_assert(!Web::permits_child<Web::H1, std::vector<Web::Div>>());
+static_assert(Web::permits_child<Web::Ul, Web::Li>());
+static_assert(!Web::permits_child<Web::Ul, Web::P>());
+static_assert(!Web::permits_child<Web::Div, Web::Li>());
+static_assert(Web::permits_child<Web::Table, Web::Tbody>());
+static_assert(Web::permits_child<Web::Tr, Web::Td>());
+static_assert(!Web::permits_child<Web::Tr, Web::Div>());
+static_assert(Web::permits_child<Web::A, Web::Span>());
+static_assert(!Web::permits_child<Web::A, Web::A>());
+static_assert(Web::permits_child<Web::Head, Web::Title>());
+static_assert(!Web::permits_child<Web::Body, Web::Title>());
+static_assert(!Web::permits_child<Web::Div, Web::Body>());
+static_assert(!Web::permits_child<Web::Img, std::string>());
+static_assert(Web::VoidElement<Web::Img>);
+static_assert(!Web::VoidElement<Web::Div>);
+
+// Rendering at compile time
+static_assert(Web::renderStatic([] { return Web::Div{ Web::P{ "x" } }; }).view() == "<div><p>x</p></div>");
+static_assert(Web::renderStatic([] {
+	return Web::Html{ Web::Body{ Web::H1{ "Title" } } };
+}).view() == "<html><body><h1>Title</h1></body></html>");
+static_assert(Web::renderStatic([] {
+	return Web::Div{ Web::Attr{ Web::Class<"center">{}, Web::Id<"main">{} }, Web::Span{ 'a', Web::Br{}, -42 } };
+}).view() == R"(<div class="center" id="main"><span>a<br/>-42</span></div>)");
+static_assert(Web::renderStatic([] {
+	return Web::P{ Web::Attr{ Web::Class{ "note" }, Web::Id<"first">{} }, std::string{ "text" } };
+}).view() == R"(<p class="note" id="first">text</p>)");
+static_assert(Web::renderStatic([] {
+	return Web::Ul{ std::vector<Web::Li>{ Web::Li{ 1 }, Web::Li{ 2 } } };
+}).view() == "<ul><li>1</li><li>2</li></ul>");
+static_assert(Web::renderStatic([] { return Web::Img{ Web::Attr{ Web::Id<"logo">{} } }; }).view() == R"(<img id="logo">)");
+
+// Generic attributes
+static_assert(Web::findStandardAttribute("href").has_value());
+static_assert(!Web::findStandardAttribute("class").has_value());
+static_assert(Web::standardAttributePrefix(*Web::findStandardAttribute("href")) == R"( href=")");
+static_assert(Web::standardAttributePrefix(*Web::findStandardAttribute("hidden")) == " hidden");
+static_assert(Web::isDataAttributeName("data-user-id"));
+static_assert(!Web::isDataAttributeName("data-User"));
+static_assert(!Web::isDataAttributeName("data-"));
+static_assert(Web::Attribute<"type", "checkbox">::text.view() == R"( type="checkbox")");
+static_assert(Web::Data<"kind", "order">::text.view() == R"( data-kind="order")");
+static_assert(Web::StaticAttribute<Web::Attribute<"type", "checkbox">>);
+static_assert(!Web::StaticAttribute<Web::Attribute<"type">>);
+static_assert(contains_duplicates<Web::attribute_key_t<Web::Attribute<"type">>, Web::attribute_key_t<Web::Attribute<"type", "text">>>::value);
+static_assert(!contains_duplicates<Web::attribute_key_t<Web::Attribute<"type">>, Web::attribute_key_t<Web::Attribute<"title">>>::value);
+static_assert(std::is_constructible_v<Web::Attribute<"width">, int>);
+static_assert(!std::is_constructible_v<Web::Attribute<"width">, const char*>);
+static_assert(!std::is_constructible_v<Web::Attribute<"href">, const char*>);
+static_assert(!std::is_constructible_v<Web::Attribute<"hidden">, int>);
+static_assert(Web::renderStatic([] {
+	return Web::Img{ Web::Attr{ Web::Attribute<"width", "64">{}, Web::Attribute<"alt">{ "Logo" }, Web::Attribute<"hidden">{ true } } };
+}).view() == R"(<img width="64" alt="Logo" hidden>)");
+
+// Class lists
+static_assert(Web::ClassList<"flex", "p-4">::prefix.view() == R"( class="flex p-4)");
+static_assert(Web::ClassList<>::prefix.view() == R"( class=")");
+static_assert(contains_duplicates<Web::attribute_key_t<Web::ClassList<"a">>, Web::attribute_key_t<Web::Class<"b">>>::value);
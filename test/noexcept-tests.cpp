@@ -0,0 +1,131 @@
+// Built with -fno-exceptions, which Catch does not support, so this file has
+// its own small runner
+#include <web.hpp>
+#include <render.hpp>
+#include <document.hpp>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#error "noexcept-tests.cpp must be built without exceptions"
+#endif
+
+namespace {
+int failures = 0;
+
+void check(bool passed, const char* expression, int line) {
+	if (!passed) {
+		std::fprintf(stderr, "noexcept-tests.cpp:%d: failed: %s\n", line, expression);
+		++failures;
+	}
+}
+#define NOEXCEPT_CHECK(...) check((__VA_ARGS__), #__VA_ARGS__, __LINE__)
+
+using Code = Web::RenderError::Code;
+
+Web::Div makePage(std::size_t rows) {
+	std::vector<Web::P> paragraphs;
+	for (std::size_t i = 0; i < rows; ++i) {
+		paragraphs.emplace_back(Web::Attr{ Web::Class{ "row" } }, "Row ", static_cast<int>(i));
+	}
+	return Web::Div{ Web::Attr{ Web::Id<"rows">{} }, std::move(paragraphs) };
+}
+
+std::string expectedPage(std::size_t rows) {
+	std::string expected = R"(<div id="rows">)";
+	for (std::size_t i = 0; i < rows; ++i) {
+		expected += R"(<p class="row">Row )" + std::to_string(i) + "</p>";
+	}
+	return expected + "</div>";
+}
+
+void fixedBufferHoldsAPageThatFits() {
+	char storage[256];
+	Web::FixedBuffer sink(storage, sizeof(storage));
+	const Web::RenderError error = Web::render(sink, makePage(3));
+	NOEXCEPT_CHECK(!error);
+	NOEXCEPT_CHECK(sink.view() == expectedPage(3));
+}
+
+void fixedBufferReportsWhenItIsFull() {
+	char storage[32];
+	Web::FixedBuffer sink(storage, sizeof(storage));
+	const Web::RenderError error = Web::render(sink, makePage(3));
+	NOEXCEPT_CHECK(error.code == Code::SinkFull);
+	NOEXCEPT_CHECK(sink.view() == std::string_view(expectedPage(3)).substr(0, sizeof(storage)));
+
+	sink.clear();
+	NOEXCEPT_CHECK(!Web::render(sink, Web::P{ "fits" }));
+	NOEXCEPT_CHECK(sink.view() == "<p>fits</p>");
+}
+
+void reallocBufferGrows() {
+	Web::ReallocBuffer sink;
+	NOEXCEPT_CHECK(!Web::render(sink, makePage(1000)));
+	NOEXCEPT_CHECK(sink.view() == expectedPage(1000));
+
+	NOEXCEPT_CHECK(!Web::render(sink, Web::Br{}));
+	NOEXCEPT_CHECK(sink.view() == expectedPage(1000) + "<br/>");
+}
+
+void reallocBufferStopsAtItsLimit() {
+	Web::ReallocBuffer sink(1000);
+	const Web::RenderError error = Web::render(sink, makePage(1000));
+	NOEXCEPT_CHECK(error.code == Code::SinkFull);
+	NOEXCEPT_CHECK(sink.size() <= 1000);
+	NOEXCEPT_CHECK(expectedPage(1000).starts_with(sink.view()));
+}
+
+void documentsRenderIntoSinks() {
+	Web::DocumentBuilder builder;
+	builder.open("ul");
+	builder.open("li");
+	builder.text("one");
+	builder.close();
+	builder.close();
+	const Web::Document document = builder.finish();
+
+	Web::ReallocBuffer sink;
+	NOEXCEPT_CHECK(!Web::render(sink, document));
+	NOEXCEPT_CHECK(sink.view() == "<ul><li>one</li></ul>");
+}
+
+void staticMarkupRendersIntoSinks() {
+	constexpr auto page = Web::renderStatic([] { return Web::P{ "static" }; });
+	char storage[32];
+	Web::FixedBuffer sink(storage, sizeof(storage));
+	NOEXCEPT_CHECK(!Web::render(sink, page));
+	NOEXCEPT_CHECK(sink.view() == "<p>static</p>");
+}
+
+// This program is built without WEB_PROFILE, unlike the Catch tests
+static_assert(!Web::profilingEnabled);
+static_assert(sizeof(Web::Profiled<Web::P>) == sizeof(Web::P), "Profiled keeps no name without profiling");
+
+void profiledRendersOnlyItsChild() {
+	const Web::Profiled profiled{ "a name long enough not to fit in a small string", Web::P{ "child" } };
+	NOEXCEPT_CHECK(profiled.getName().empty());
+	Web::ReallocBuffer sink;
+	NOEXCEPT_CHECK(!Web::render(sink, Web::Div{ profiled }));
+	NOEXCEPT_CHECK(sink.view() == "<div><p>child</p></div>");
+}
+}
+
+int main() {
+	fixedBufferHoldsAPageThatFits();
+	fixedBufferReportsWhenItIsFull();
+	reallocBufferGrows();
+	reallocBufferStopsAtItsLimit();
+	documentsRenderIntoSinks();
+	staticMarkupRendersIntoSinks();
+	profiledRendersOnlyItsChild();
+
+	if (failures != 0) {
+		std::fprintf(stderr, "%d checks failed\n", failures);
+		return 1;
+	}
+	std::puts("All noexcept tests passed");
+	return 0;
+}
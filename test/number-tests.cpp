@@ -0,0 +1,61 @@
+#include "catch.hpp"
+#include "support/to-string.hpp"
+#include <web.hpp>
+#include <locale>
+#include <sstream>
+#include <string>
+
+using Web::Test::toString;
+
+namespace {
+struct GroupingPunct : std::numpunct<char> {
+	char do_thousands_sep() const override { return '#'; }
+	std::string do_grouping() const override { return "\1"; }
+};
+}
+
+TEST_CASE("Integers render as children")
+{
+	auto p = Web::P{ 42, " items, ", -7 };
+	REQUIRE(toString(p) == "<p>42 items, -7</p>");
+}
+
+TEST_CASE("Floating point renders using the shortest representation")
+{
+	auto p = Web::P{ 3.14159265, " ", 0.5f };
+	REQUIRE(toString(p) == "<p>3.14159265 0.5</p>");
+}
+
+TEST_CASE("Vectors of numbers render each number")
+{
+	auto p = Web::P{ std::vector<int>{ 1, 2, 3 } };
+	REQUIRE(toString(p) == "<p>123</p>");
+}
+
+TEST_CASE("Numbers ignore the stream locale")
+{
+	std::stringstream ss;
+	ss.imbue(std::locale(ss.getloc(), new GroupingPunct));
+	ss << Web::P{ 123456 };
+	REQUIRE(ss.str() == "<p>123456</p>");
+}
+
+TEST_CASE("Number can use fixed decimals")
+{
+	REQUIRE(toString(Web::Number{ 9.5, { .precision = 2 } }) == "9.50");
+	REQUIRE(toString(Web::Number{ 2.0 / 3.0, { .precision = 3 } }) == "0.667");
+	REQUIRE(toString(Web::Number{ 12, { .precision = 2 } }) == "12.00");
+}
+
+TEST_CASE("Number can use thousands separators")
+{
+	REQUIRE(toString(Web::Number{ 1234567, { .thousandsSeparator = ',' } }) == "1,234,567");
+	REQUIRE(toString(Web::Number{ -1234, { .thousandsSeparator = ',' } }) == "-1,234");
+	REQUIRE(toString(Web::Number{ 123, { .thousandsSeparator = ',' } }) == "123");
+	REQUIRE(toString(Web::Number{ 1234567.891, { .precision = 2, .thousandsSeparator = ' ' } }) == "1 234 567.89");
+}
+
+TEST_CASE("Characters still render as text")
+{
+	REQUIRE(toString(Web::P{ 'x' }) == "<p>x</p>");
+}
@@ -0,0 +1,97 @@
+#include "catch.hpp"
+#include "support/to-string.hpp"
+#include <parser.hpp>
+#include <string>
+
+using Web::Test::toString;
+
+namespace {
+std::string roundTrip(std::string_view html) {
+	auto doc = Web::parseHtml(html);
+	REQUIRE(doc);
+	return toString(*doc);
+}
+
+Web::ParseError::Code errorOf(std::string_view html) {
+	return Web::validateHtml(html).code;
+}
+}
+
+TEST_CASE("Parsed markup renders back unchanged")
+{
+	const std::string html = R"(<div class="a" id="b"><h1>Title</h1><p>Some &amp; text &#169; &#x2014;</p></div>)";
+	REQUIRE(roundTrip(html) == html);
+}
+
+TEST_CASE("Parsed void elements have no closing tag")
+{
+	REQUIRE(roundTrip("<p>one<br>two<br/><img src=\"a.png\" alt='x'></p>") == R"(<p>one<br>two<br><img src="a.png" alt="x"></p>)");
+}
+
+TEST_CASE("Parsed attributes are normalised to double quotes")
+{
+	REQUIRE(roundTrip("<input type=text disabled>") == R"(<input type="text" disabled="">)");
+	REQUIRE(roundTrip(R"(<a title='say "hi"'></a>)") == R"(<a title="say &quot;hi&quot;"></a>)");
+}
+
+TEST_CASE("Comments, doctypes and scripts pass through")
+{
+	const std::string html = "<!DOCTYPE html><html><!-- a <b> comment --><script>if (a < b && c) {}</script></html>";
+	REQUIRE(roundTrip(html) == html);
+}
+
+TEST_CASE("Parsed documents use the document tables")
+{
+	auto doc = Web::parseHtml("<ul><li>a</li><li>b</li></ul>");
+	REQUIRE(doc);
+	REQUIRE(doc->getNodes().size() == 5);
+	const auto [first, last] = doc->getRoots();
+	REQUIRE(last - first == 1);
+	REQUIRE(doc->getNodes()[*first].childCount == 2);
+}
+
+TEST_CASE("Malformed markup is rejected")
+{
+	using Code = Web::ParseError::Code;
+	REQUIRE(errorOf("<div><p>text</div>") == Code::UnexpectedEndTag);
+	REQUIRE(errorOf("<div>") == Code::UnclosedElement);
+	REQUIRE(errorOf("</div>") == Code::UnexpectedEndTag);
+	REQUIRE(errorOf("<div class=\"a></div>") == Code::MalformedTag);
+	REQUIRE(errorOf("<p>fish & chips</p>") == Code::MalformedEntity);
+	REQUIRE(errorOf("<p>&amp</p>") == Code::MalformedEntity);
+	REQUIRE(errorOf("<!-- open") == Code::UnterminatedComment);
+	REQUIRE(errorOf("< p>") == Code::MalformedTag);
+	REQUIRE(errorOf("<script>x") == Code::UnclosedElement);
+	REQUIRE(errorOf("<div<p>></div<p>>") == Code::MalformedTag);
+	REQUIRE(errorOf("<p\"x>text</p>") == Code::MalformedTag);
+	REQUIRE(errorOf("<p='x'>text</p>") == Code::MalformedTag);
+}
+
+TEST_CASE("Raw text ends only at its own end tag")
+{
+	const std::string html = "<script>a = '</scripts>';</script >";
+	REQUIRE(roundTrip(html) == "<script>a = '</scripts>';</script>");
+	REQUIRE(errorOf("<script></scripts>") == Web::ParseError::Code::UnclosedElement);
+}
+
+TEST_CASE("Errors report where they happened")
+{
+	const auto error = Web::validateHtml("<div><p>text</div>");
+	REQUIRE(error.offset == 12);
+}
+
+TEST_CASE("Long runs of text are scanned correctly")
+{
+	const std::string text(1000, 'x');
+	REQUIRE(roundTrip("<p>" + text + "&lt;" + text + "</p>") == "<p>" + text + "&lt;" + text + "</p>");
+	REQUIRE(errorOf("<p>" + text + "&" + text + "</p>") == Web::ParseError::Code::MalformedEntity);
+}
+
+TEST_CASE("RawHtml validates once and renders verbatim")
+{
+	REQUIRE_FALSE(Web::RawHtml::create("<div>"));
+
+	auto raw = Web::RawHtml::create("<b>bold</b> text");
+	REQUIRE(raw);
+	REQUIRE(toString(Web::P{ *raw }) == "<p><b>bold</b> text</p>");
+}
@@ -0,0 +1,102 @@
+#include "catch.hpp"
+#include <web.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static_assert(Web::profilingEnabled, "web-tests is built with WEB_PROFILE=1");
+
+namespace {
+const Web::RenderProfiler::Frame* findFrame(const Web::RenderProfiler& profiler, const std::vector<std::string>& path) {
+	const auto& frames = profiler.getFrames();
+	std::size_t current = 0;
+	for (const auto& name : path) {
+		std::size_t child = frames[current].firstChild;
+		while (child != Web::RenderProfiler::npos && frames[child].name != name) {
+			child = frames[child].nextSibling;
+		}
+		if (child == Web::RenderProfiler::npos) {
+			return nullptr;
+		}
+		current = child;
+	}
+	return &frames[current];
+}
+}
+
+TEST_CASE("Rendering without a profiler records nothing")
+{
+	REQUIRE(Web::RenderProfiler::current() == nullptr);
+	std::stringstream stream;
+	stream << Web::Div{ Web::P{ "text" } };
+	REQUIRE(stream.str() == "<div><p>text</p></div>");
+}
+
+TEST_CASE("Profiler records a frame per element position")
+{
+	Web::RenderProfiler profiler;
+	std::stringstream stream;
+	stream << Web::Div{ Web::P{ "one" }, Web::P{ "two" }, Web::Span{ "three" } };
+
+	const auto* div = findFrame(profiler, { "div" });
+	REQUIRE(div != nullptr);
+	REQUIRE(div->calls == 1);
+	REQUIRE(div->childCount == 3);
+	REQUIRE(div->bytes == stream.str().size());
+
+	const auto* p = findFrame(profiler, { "div", "p" });
+	REQUIRE(p != nullptr);
+	REQUIRE(p->calls == 2);
+	REQUIRE(p->bytes == std::string("<p>one</p><p>two</p>").size());
+	REQUIRE(p->total <= div->total);
+}
+
+TEST_CASE("Profiled components get their own frame")
+{
+	Web::RenderProfiler profiler;
+	std::stringstream stream;
+	stream << Web::Body{ Web::Profiled{ "navigation", Web::Nav{ Web::A{ "home" } } } };
+	REQUIRE(stream.str() == "<body><nav><a>home</a></nav></body>");
+
+	REQUIRE(findFrame(profiler, { "body", "navigation", "nav", "a" }) != nullptr);
+	REQUIRE(findFrame(profiler, { "body", "nav" }) == nullptr);
+}
+
+TEST_CASE("Profiler exports folded stacks")
+{
+	Web::RenderProfiler profiler;
+	std::stringstream stream;
+	stream << Web::Div{ Web::P{ "text" } };
+
+	std::istringstream folded(profiler.foldedStacks());
+	std::vector<std::string> stacks;
+	std::string stack;
+	long long nanoseconds;
+	while (folded >> stack >> nanoseconds) {
+		stacks.push_back(stack);
+		REQUIRE(nanoseconds >= 0);
+	}
+	REQUIRE((stacks == std::vector<std::string>{ "div", "div;p" }));
+}
+
+TEST_CASE("Profiler exports a JSON summary per name")
+{
+	Web::RenderProfiler profiler;
+	std::stringstream stream;
+	stream << Web::Div{ Web::Div{ Web::P{ "a" } }, Web::P{ "b" }, Web::Profiled{ "say \"hi\"", Web::Span{ "c" } } };
+
+	const auto json = profiler.jsonSummary();
+	REQUIRE(json.find("{\"name\":\"div\",\"calls\":2,") != std::string::npos);
+	REQUIRE(json.find("{\"name\":\"p\",\"calls\":2,") != std::string::npos);
+	REQUIRE(json.find("\"name\":\"say \\\"hi\\\"\"") != std::string::npos);
+}
+
+TEST_CASE("Profilers nest and restore the previous session")
+{
+	Web::RenderProfiler outer;
+	{
+		Web::RenderProfiler inner;
+		REQUIRE(Web::RenderProfiler::current() == &inner);
+	}
+	REQUIRE(Web::RenderProfiler::current() == &outer);
+}
@@ -0,0 +1,109 @@
+#include "catch.hpp"
+#include "support/to-string.hpp"
+#include <raw-file.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using Web::Test::toString;
+
+namespace {
+class TemporaryFile {
+	std::filesystem::path path;
+public:
+	TemporaryFile(const std::string& name, const std::string& contents) :
+		path(std::filesystem::temp_directory_path() / name)
+	{
+		write(contents);
+	}
+	~TemporaryFile() {
+		std::filesystem::remove(path);
+	}
+
+	// Replaces the file rather than rewriting it, as mapped files must be updated
+	void write(const std::string& contents) {
+		auto next = path;
+		next += ".next";
+		{
+			std::ofstream file(next, std::ios::binary | std::ios::trunc);
+			file << contents;
+		}
+		std::filesystem::rename(next, path);
+	}
+
+	std::string getPath() const {
+		return path.string();
+	}
+};
+}
+
+TEST_CASE("RawFile renders the file contents")
+{
+	TemporaryFile file("web-cpp-raw-file-footer.html", "<footer><p>&copy; Example</p></footer>");
+	auto raw = Web::RawFile::open(file.getPath());
+	REQUIRE(raw);
+
+	auto doc = Web::Body{ Web::P{ "content" }, *raw };
+	REQUIRE(toString(doc) == "<body><p>content</p><footer><p>&copy; Example</p></footer></body>");
+	REQUIRE(raw->snapshot()->view() == "<footer><p>&copy; Example</p></footer>");
+}
+
+TEST_CASE("RawFile rejects missing and invalid files")
+{
+	Web::RawFileError error;
+	REQUIRE_FALSE(Web::RawFile::open("/this/file/does/not/exist.html", {}, &error));
+	REQUIRE(error.code == Web::RawFileError::Code::CannotOpen);
+
+	TemporaryFile file("web-cpp-raw-file-invalid.html", "<div><p>unclosed</div>");
+	REQUIRE_FALSE(Web::RawFile::open(file.getPath(), {}, &error));
+	REQUIRE(error.code == Web::RawFileError::Code::InvalidHtml);
+	REQUIRE(error.html.code == Web::ParseError::Code::UnexpectedEndTag);
+}
+
+TEST_CASE("RawFile can be empty")
+{
+	TemporaryFile file("web-cpp-raw-file-empty.html", "");
+	auto raw = Web::RawFile::open(file.getPath());
+	REQUIRE(raw);
+	REQUIRE(toString(Web::Div{ *raw }) == "<div></div>");
+}
+
+TEST_CASE("RawFile only reloads when asked to")
+{
+	TemporaryFile file("web-cpp-raw-file-reload.html", "<p>first</p>");
+	auto fixed = Web::RawFile::open(file.getPath());
+	auto reloading = Web::RawFile::open(file.getPath(), { .reloadOnChange = true });
+	REQUIRE(fixed);
+	REQUIRE(reloading);
+
+	// Keep the modification time distinct from the first write
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	file.write("<p>second</p>");
+
+	REQUIRE(toString(*fixed) == "<p>first</p>");
+	REQUIRE(toString(*reloading) == "<p>second</p>");
+
+	// Invalid changes keep the last valid contents
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	file.write("<p>broken");
+	REQUIRE(toString(*reloading) == "<p>second</p>");
+	REQUIRE(!reloading->reloadIfChanged());
+}
+
+TEST_CASE("RawFile notices a replacement with the same modification time")
+{
+	TemporaryFile file("web-cpp-raw-file-same-time.html", "<p>first</p>");
+	auto reloading = Web::RawFile::open(file.getPath(), { .reloadOnChange = true });
+	REQUIRE(reloading);
+	const auto modified = std::filesystem::last_write_time(file.getPath());
+
+	file.write("<p>broken");
+	std::filesystem::last_write_time(file.getPath(), modified);
+	REQUIRE(toString(*reloading) == "<p>first</p>");
+
+	// A failed version is skipped, but fixing it is seen even within the same timestamp
+	file.write("<p>fixed</p>");
+	std::filesystem::last_write_time(file.getPath(), modified);
+	REQUIRE(toString(*reloading) == "<p>fixed</p>");
+}
@@ -0,0 +1,93 @@
+#include "catch.hpp"
+#include "support/allocation-counter.hpp"
+#include "support/to-string.hpp"
+#include <shared.hpp>
+#include <render.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Web::Test::toString;
+
+namespace {
+// Counts how many times it is rendered
+struct Counted {
+	int* renders;
+};
+std::ostream& operator<<(std::ostream& stream, const Counted& counted) {
+	++*counted.renders;
+	return stream << "counted";
+}
+}
+
+TEST_CASE("Shared subtree renders like the subtree itself")
+{
+	const Web::Shared nav{ Web::Nav{ Web::Ul{ Web::Li{ Web::A{ "Home" } }, Web::Li{ Web::A{ "About" } } } } };
+	const auto page = Web::Html{ Web::Body{ nav, Web::P{ "content" } } };
+
+	REQUIRE(toString(page) == "<html><body><nav><ul><li><a>Home</a></li><li><a>About</a></li></ul></nav><p>content</p></body></html>");
+	REQUIRE(toString(nav.get()) == nav.bytes());
+}
+
+TEST_CASE("Shared subtree is rendered once")
+{
+	int renders = 0;
+	const Web::Shared footer{ Web::Footer{ Web::P{ Counted{ &renders } } } };
+
+	for (int i = 0; i < 3; ++i) {
+		REQUIRE(toString(Web::Body{ Web::P{ "page ", i }, footer }) == "<body><p>page " + std::to_string(i) + "</p><footer><p>counted</p></footer></body>");
+	}
+	REQUIRE(renders == 1);
+}
+
+TEST_CASE("Copies of a shared subtree share its cache")
+{
+	int renders = 0;
+	const Web::Shared header{ Web::Header{ Web::P{ Counted{ &renders } } } };
+	const auto copy = header;
+	REQUIRE(copy.bytes().data() == header.bytes().data());
+	REQUIRE(renders == 1);
+	REQUIRE_NO_ALLOCATIONS(Web::Shared copyAgain = header);
+}
+
+TEST_CASE("Moving a shared subtree leaves the source usable")
+{
+	Web::Shared source{ Web::P{ "text" } };
+	const Web::Shared moved = std::move(source);
+	REQUIRE(moved.bytes() == "<p>text</p>");
+	REQUIRE(source.bytes() == "<p>text</p>");
+}
+
+TEST_CASE("Shared subtree can be rendered from many threads")
+{
+	int renders = 0;
+	const Web::Shared footer{ Web::Footer{ Web::P{ Counted{ &renders } }, Web::P{ "(c) Example" } } };
+	const std::string expected = "<footer><p>counted</p><p>(c) Example</p></footer>";
+
+	std::vector<std::string> results(8);
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		threads.emplace_back([&, i] {
+			results[i] = toString(Web::Div{ footer });
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	for (const auto& result : results) {
+		REQUIRE(result == "<div>" + expected + "</div>");
+	}
+	REQUIRE(renders == 1);
+}
+
+TEST_CASE("Rendering a cached shared subtree does not allocate")
+{
+	const Web::Shared nav{ Web::Nav{ Web::P{ "links" } } };
+	nav.bytes();
+	const auto page = Web::Body{ nav };
+	std::string out;
+	out.reserve(256);
+	REQUIRE_NO_ALLOCATIONS(Web::render(out, page));
+	REQUIRE(out == "<body><nav><p>links</p></nav></body>");
+}
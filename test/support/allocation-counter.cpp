@@ -0,0 +1,72 @@
+#include "allocation-counter.hpp"
+#include <cstdlib>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#include <new>
+
+namespace {
+thread_local Web::Test::AllocationStats stats;
+
+void* allocate(std::size_t size) noexcept {
+	++stats.allocations;
+	stats.bytes += size;
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+	++stats.allocations;
+	stats.bytes += size;
+	const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+	return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+	// aligned_alloc wants a size that is a multiple of the alignment
+	const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+	return std::aligned_alloc(align, rounded);
+#endif
+}
+
+void freeAligned(void* memory) noexcept {
+#ifdef _WIN32
+	_aligned_free(memory);
+#else
+	std::free(memory);
+#endif
+}
+
+void* allocateOrThrow(void* memory) {
+	if (!memory) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+}
+
+namespace Web::Test {
+	AllocationStats allocationStats() {
+		return stats;
+	}
+}
+
+void* operator new(std::size_t size) { return allocateOrThrow(allocate(size)); }
+void* operator new[](std::size_t size) { return allocateOrThrow(allocate(size)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateOrThrow(allocateAligned(size, alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateOrThrow(allocateAligned(size, alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { freeAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { freeAligned(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { freeAligned(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { freeAligned(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(memory); }
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+
+// Counts calls to the global operator new on the current thread, so tests can
+// pin down which code paths allocate. Linking web-test-support replaces the
+// global allocation functions for the whole executable.
+namespace Web::Test {
+
+	struct AllocationStats {
+		std::size_t allocations = 0;
+		std::size_t bytes = 0;
+	};
+
+	// The totals for this thread since it started
+	AllocationStats allocationStats();
+
+	// Measures the allocations made between construction and a call to get()
+	class AllocationCounter {
+		AllocationStats start;
+	public:
+		AllocationCounter() :
+			start(allocationStats())
+		{}
+
+		AllocationStats get() const {
+			const AllocationStats now = allocationStats();
+			return AllocationStats{ now.allocations - start.allocations, now.bytes - start.bytes };
+		}
+	};
+}
+
+#define WEB_ALLOCATIONS_IN(...) ([&] {						\
+		const Web::Test::AllocationCounter counter_;			\
+		__VA_ARGS__;											\
+		return counter_.get().allocations;						\
+	}())
+
+// Evaluates the expression and fails if it allocated
+#define REQUIRE_NO_ALLOCATIONS(...) do {						\
+		INFO("Expression: " #__VA_ARGS__);						\
+		REQUIRE(WEB_ALLOCATIONS_IN(__VA_ARGS__) == 0u);			\
+	} while (false)
+
+#define CHECK_NO_ALLOCATIONS(...) do {							\
+		INFO("Expression: " #__VA_ARGS__);						\
+		CHECK(WEB_ALLOCATIONS_IN(__VA_ARGS__) == 0u);			\
+	} while (false)
+
+// Evaluates the expression and fails if it allocated more than LIMIT times
+#define REQUIRE_ALLOCATIONS_AT_MOST(LIMIT, ...) do {			\
+		INFO("Expression: " #__VA_ARGS__);						\
+		REQUIRE(WEB_ALLOCATIONS_IN(__VA_ARGS__) <= (LIMIT));	\
+	} while (false)
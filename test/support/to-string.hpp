@@ -0,0 +1,14 @@
+#pragma once
+#include <sstream>
+#include <string>
+
+namespace Web::Test {
+
+	// The markup anything streamable renders to, for comparing against text
+	template <typename T>
+	std::string toString(const T& value) {
+		std::stringstream ss;
+		ss << value;
+		return ss.str();
+	}
+}
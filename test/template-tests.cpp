@@ -0,0 +1,82 @@
+#include "catch.hpp"
+#include <template.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+template <typename... Args, typename... Values>
+std::string render(const Web::Template<Args...>& tmpl, const Values&... values) {
+	std::stringstream ss;
+	tmpl.render(ss, values...);
+	return ss.str();
+}
+}
+
+TEST_CASE("Template without slots renders the static document")
+{
+	const Web::Template<> tmpl{
+		Web::Div{ Web::P{ "text" } }
+	};
+
+	REQUIRE(render(tmpl) == "<div><p>text</p></div>");
+	REQUIRE(tmpl.segmentCount() == 1);
+}
+
+TEST_CASE("Template fills slots from arguments")
+{
+	const Web::Template<std::string, int> tmpl{
+		Web::Html {
+			Web::Body {
+				Web::H1{ Web::Slot<0, std::string>{} },
+				Web::P{ "Count: ", Web::Slot<1, int>{} }
+			}
+		}
+	};
+
+	REQUIRE(render(tmpl, std::string("Title"), 3) == "<html><body><h1>Title</h1><p>Count: 3</p></body></html>");
+	REQUIRE(render(tmpl, std::string("Other"), 42) == "<html><body><h1>Other</h1><p>Count: 42</p></body></html>");
+	REQUIRE(tmpl.segmentCount() == 5);
+}
+
+TEST_CASE("Template slots can be repeated and reordered")
+{
+	const Web::Template<std::string, std::string> tmpl{
+		Web::Div{ Web::Slot<1, std::string>{}, Web::Slot<0, std::string>{}, Web::Slot<1, std::string>{} }
+	};
+
+	REQUIRE(render(tmpl, std::string("a"), std::string("b")) == "<div>bab</div>");
+}
+
+TEST_CASE("Template slots can hold elements")
+{
+	const Web::Template<std::vector<Web::P>> tmpl{
+		Web::Div{ Web::Slot<0, std::vector<Web::P>>{} }
+	};
+
+	std::vector<Web::P> paragraphs;
+	paragraphs.push_back(Web::P{ "first" });
+	paragraphs.push_back(Web::P{ "second" });
+
+	REQUIRE(render(tmpl, paragraphs) == "<div><p>first</p><p>second</p></div>");
+}
+
+// The slot checks do not depend on assert, so these hold in release builds too
+TEST_CASE("Template rejects a slot without a matching argument")
+{
+	REQUIRE_THROWS_AS(Web::Template<std::string>(Web::Div{ Web::Slot<1, std::string>{} }), const std::invalid_argument&);
+	REQUIRE_THROWS_AS(Web::Template<>(Web::Div{ Web::Slot<0, int>{} }), const std::invalid_argument&);
+}
+
+TEST_CASE("Template rejects a slot whose type differs from its argument")
+{
+	REQUIRE_THROWS_AS(Web::Template<std::string>(Web::Div{ Web::Slot<0, int>{} }), const std::invalid_argument&);
+}
+
+TEST_CASE("Slot outside a Template fails the stream")
+{
+	std::stringstream ss;
+	ss << Web::Div{ Web::Slot<0, std::string>{} };
+	REQUIRE(ss.fail());
+}
@@ -0,0 +1,142 @@
+#include "catch.hpp"
+#include "support/to-string.hpp"
+#include <uring.hpp>
+
+#ifndef _WIN32
+#include <web.hpp>
+#include <csignal>
+#include <cstdio>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using Web::Test::toString;
+
+namespace {
+Web::Ul bigList(int count) {
+	std::vector<Web::Li> items;
+	for (int i = 0; i < count; ++i) {
+		items.push_back(Web::Li{ "item ", i });
+	}
+	return Web::Ul{ std::move(items) };
+}
+
+std::string readAll(int fd) {
+	std::string bytes;
+	char buffer[4096];
+	ssize_t count;
+	while ((count = ::read(fd, buffer, sizeof(buffer))) > 0) {
+		bytes.append(buffer, static_cast<std::size_t>(count));
+	}
+	return bytes;
+}
+
+// Small buffers so a render spans many submissions and batches
+constexpr Web::UringOptions smallBuffers{ .bufferCount = 4, .bufferSize = 4096, .batchSize = 2 };
+
+std::string renderToFile(const Web::UringOptions& options, const std::string& prefix) {
+	char path[] = "/tmp/web-uring-XXXXXX";
+	const int fd = ::mkstemp(path);
+	REQUIRE(fd >= 0);
+	REQUIRE(::write(fd, prefix.data(), prefix.size()) == static_cast<ssize_t>(prefix.size()));
+	{
+		Web::UringBuffer buffer(fd, options);
+		std::ostream stream(&buffer);
+		stream << bigList(5000) << std::flush;
+		REQUIRE(stream.good());
+		REQUIRE(!buffer.hasFailed());
+		stream << "<!-- end -->";
+	}
+	::close(fd);
+
+	const int reader = ::open(path, O_RDONLY);
+	const std::string bytes = readAll(reader);
+	::close(reader);
+	::unlink(path);
+	return bytes;
+}
+}
+
+TEST_CASE("UringBuffer writes a render to a file after existing content")
+{
+	const std::string expected = "<!DOCTYPE html>" + toString(bigList(5000)) + "<!-- end -->";
+	REQUIRE(renderToFile(smallBuffers, "<!DOCTYPE html>") == expected);
+
+	auto fallback = smallBuffers;
+	fallback.forceFallback = true;
+	REQUIRE(renderToFile(fallback, "<!DOCTYPE html>") == expected);
+}
+
+TEST_CASE("UringBuffer keeps a socket stream in order")
+{
+	int fds[2];
+	REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+	const int size = 4096;
+	::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)); // Forces short writes
+
+	std::string received;
+	std::thread reader([&] {
+		received = readAll(fds[1]);
+	});
+	{
+		Web::UringBuffer buffer(fds[0], smallBuffers);
+		std::ostream stream(&buffer);
+		stream << bigList(20000);
+	}
+	::close(fds[0]);
+	reader.join();
+	::close(fds[1]);
+
+	REQUIRE(received == toString(bigList(20000)));
+}
+
+TEST_CASE("UringBuffer batches buffers into fewer submissions")
+{
+	int fds[2];
+	REQUIRE(::pipe(fds) == 0);
+	std::string received;
+	std::thread reader([&] {
+		received = readAll(fds[0]);
+	});
+
+	std::size_t submissions = 0;
+	bool uring = false;
+	{
+		Web::UringBuffer buffer(fds[1], { .bufferCount = 8, .bufferSize = 4096, .batchSize = 4 });
+		std::ostream stream(&buffer);
+		stream << bigList(5000) << std::flush;
+		submissions = buffer.getSubmissionCount();
+		uring = buffer.usesUring();
+	}
+	::close(fds[1]);
+	reader.join();
+	::close(fds[0]);
+
+	REQUIRE(received == toString(bigList(5000)));
+	const std::size_t buffersWritten = (received.size() + 4095) / 4096;
+	if (uring) {
+		REQUIRE(submissions < buffersWritten);
+	}
+	else {
+		REQUIRE(submissions == buffersWritten);
+	}
+}
+
+TEST_CASE("UringBuffer reports a closed reader as a failed stream")
+{
+	int fds[2];
+	REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+	::close(fds[1]);
+	std::signal(SIGPIPE, SIG_IGN);
+
+	Web::UringBuffer buffer(fds[0], smallBuffers);
+	std::ostream stream(&buffer);
+	stream << bigList(5000) << std::flush;
+	REQUIRE(!stream.good());
+	REQUIRE(buffer.hasFailed());
+	::close(fds[0]);
+}
+#endif
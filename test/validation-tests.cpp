@@ -0,0 +1,127 @@
+#include "catch.hpp"
+#include "support/to-string.hpp"
+#include <web.hpp>
+#include <document.hpp>
+#include <string>
+#include <vector>
+
+using Web::Test::toString;
+
+namespace {
+std::vector<Web::ValidationError::Code> errors;
+std::vector<std::string> subjects;
+
+void recordError(const Web::ValidationError& error) {
+	errors.push_back(error.code);
+	subjects.emplace_back(error.subject);
+}
+
+// Collects validation errors instead of asserting while in scope
+class RecordErrors {
+	Web::ValidationHandler previous;
+public:
+	RecordErrors() :
+		previous(Web::setValidationHandler(recordError))
+	{
+		errors.clear();
+		subjects.clear();
+	}
+	~RecordErrors() {
+		Web::setValidationHandler(previous);
+	}
+};
+
+WEB_HTML_TAG_NO_VALIDATION(Custom, "custom-element");
+}
+
+static_assert(Web::validationEnabled, "The tests are built with runtime validation");
+
+TEST_CASE("Valid documents report nothing")
+{
+	RecordErrors record;
+	std::vector<Web::Div> items;
+	items.push_back(Web::Div{ Web::Attr{ Web::Id{ "a" } } });
+	items.push_back(Web::Div{ Web::Attr{ Web::Id{ "b" } } });
+	toString(Web::Body{ Web::Div{ Web::Attr{ Web::Id<"c">{} } }, std::move(items) });
+
+	REQUIRE(errors.empty());
+}
+
+TEST_CASE("Duplicate ids in a vector are reported")
+{
+	RecordErrors record;
+	std::vector<Web::P> items;
+	for (int i = 0; i < 3; ++i) {
+		items.push_back(Web::P{ Web::Attr{ Web::Id{ "item" } } });
+	}
+	toString(Web::Div{ std::move(items) });
+
+	REQUIRE((errors == std::vector{ Web::ValidationError::Code::DuplicateId, Web::ValidationError::Code::DuplicateId }));
+	REQUIRE(subjects[0] == "item");
+}
+
+TEST_CASE("Compile time ids are checked against runtime ids")
+{
+	RecordErrors record;
+	toString(Web::Div{ Web::Div{ Web::Attr{ Web::Id<"main">{} } }, Web::Div{ Web::Attr{ Web::Id{ "main" } } } });
+
+	REQUIRE((errors == std::vector{ Web::ValidationError::Code::DuplicateId }));
+}
+
+TEST_CASE("Ids are only unique within one document")
+{
+	RecordErrors record;
+	auto d = Web::Div{ Web::Attr{ Web::Id{ "main" } } };
+	toString(d);
+	toString(d);
+
+	REQUIRE(errors.empty());
+}
+
+TEST_CASE("Many ids do not collide")
+{
+	RecordErrors record;
+	std::vector<Web::P> items;
+	for (int i = 0; i < 1000; ++i) {
+		items.push_back(Web::P{ Web::Attr{ Web::Id{ "item-" + std::to_string(i) } } });
+	}
+	items.push_back(Web::P{ Web::Attr{ Web::Id{ "item-500" } } });
+	toString(Web::Div{ std::move(items) });
+
+	REQUIRE((errors == std::vector{ Web::ValidationError::Code::DuplicateId }));
+	REQUIRE(subjects[0] == "item-500");
+}
+
+TEST_CASE("Invalid attribute values are reported")
+{
+	RecordErrors record;
+	toString(Web::Div{ Web::Attr{ Web::Id{ "two words" }, Web::Class{ "a\"b" } } });
+
+	REQUIRE((errors == std::vector{ Web::ValidationError::Code::InvalidAttributeValue, Web::ValidationError::Code::InvalidAttributeValue }));
+}
+
+TEST_CASE("Nesting through unchecked elements is validated at runtime")
+{
+	RecordErrors record;
+	toString(Web::P{ Custom{ Web::Div{ "block" } } });
+
+	REQUIRE((errors == std::vector{ Web::ValidationError::Code::InvalidNesting }));
+	REQUIRE(subjects[0] == "div");
+
+	errors.clear();
+	toString(Web::Div{ Custom{ Web::Div{ "block" } } });
+	REQUIRE(errors.empty());
+}
+
+TEST_CASE("Forbidden content is checked through every descendant")
+{
+	RecordErrors record;
+	toString(Web::A{ Web::Span{ Web::Em{ Web::A{ "inner" } } } });
+
+	REQUIRE((errors == std::vector{ Web::ValidationError::Code::InvalidNesting }));
+	REQUIRE(subjects[0] == "a");
+
+	errors.clear();
+	toString(Web::Div{ Web::A{ Web::Span{ "one" } }, Web::Span{ Web::A{ "two" } } });
+	REQUIRE(errors.empty());
+}